@@ -34,13 +34,13 @@ using online_rlbwt = itmmti::OnlineRlbwtIndex<DynRleT, DynSuccT>;
 template <>
 void build_index<move_r<_locate_move, char, uint32_t>>(move_r<_locate_move, char, uint32_t>& index, uint16_t num_threads)
 {
-    index = move_r<_locate_move, char, uint32_t>(input, { .mode = _bigbwt, .num_threads = num_threads });
+    index = move_r<_locate_move, char, uint32_t>(input, { .mode = _pfp, .num_threads = num_threads });
 }
 
 template <>
 void build_index<move_r<_locate_move, char, uint64_t>>(move_r<_locate_move, char, uint64_t>& index, uint16_t num_threads)
 {
-    index = move_r<_locate_move, char, uint64_t>(input, { .mode = _bigbwt, .num_threads = num_threads });
+    index = move_r<_locate_move, char, uint64_t>(input, { .mode = _pfp, .num_threads = num_threads });
 }
 
 template <>
@@ -105,13 +105,13 @@ void locate_pattern<uint64_t, move_r<_locate_move, char, uint64_t>>(move_r<_loca
 template <>
 void build_index<move_r<_locate_rlzdsa, char, uint32_t>>(move_r<_locate_rlzdsa, char, uint32_t>& index, uint16_t num_threads)
 {
-    index = move_r<_locate_rlzdsa, char, uint32_t>(input, { .mode = _bigbwt, .num_threads = num_threads });
+    index = move_r<_locate_rlzdsa, char, uint32_t>(input, { .mode = _pfp, .num_threads = num_threads });
 }
 
 template <>
 void build_index<move_r<_locate_rlzdsa, char, uint64_t>>(move_r<_locate_rlzdsa, char, uint64_t>& index, uint16_t num_threads)
 {
-    index = move_r<_locate_rlzdsa, char, uint64_t>(input, { .mode = _bigbwt, .num_threads = num_threads });
+    index = move_r<_locate_rlzdsa, char, uint64_t>(input, { .mode = _pfp, .num_threads = num_threads });
 }
 
 template <>
@@ -6,9 +6,24 @@ int ptr = 1;
 uint64_t n;
 uint16_t a = 8;
 uint16_t p = 1;
+uint64_t seed = 0;
+std::string path_reference;
+bool embed_reference = true;
+bool calibrate_min_occ = false;
+std::string path_export_reference;
+std::string path_tuning_patterns;
+uint64_t max_size_in_bytes = std::numeric_limits<uint64_t>::max();
+uint64_t max_memory = 0;
+std::string checkpoint_dir;
+bool resume = false;
+bool keep_checkpoint = false;
+std::string tmp_dir;
+bool use_mmap = false;
 std::string path_prefix_index_file;
 move_r_construction_mode mode = _suffix_array;
-move_r_support support = _locate_move;
+bool input_bwt = false;
+move_r_support support = _locate_move; // support covering all supports in supports
+std::vector<move_r_support> supports = { _locate_move }; // supports to build an index with
 std::ofstream mf_idx;
 std::ofstream mf_mds;
 std::ifstream input_file;
@@ -17,18 +32,56 @@ std::string path_input_file;
 std::string name_text_file;
 std::string path_index_file;
 
+std::string support_name(move_r_support sup)
+{
+    switch (sup) {
+    case _count: return "count";
+    case _locate_one: return "locate_one";
+    case _locate_move: return "locate_move";
+    case _locate_rlzdsa: return "locate_rlzdsa";
+    default: return "locate_hybrid";
+    }
+}
+
 void help(std::string msg)
 {
     if (msg != "") std::cout << msg << std::endl;
     std::cout << "move-r-build: builds move-r." << std::endl << std::endl;
     std::cout << "usage: move-r-build [options] <input_file>" << std::endl;
-    std::cout << "   -c <mode>          construction mode: sa or bigbwt (default: sa)" << std::endl;
+    std::cout << "   -c <mode>          construction mode: sa or pfp (prefix-free parsing; default: sa)" << std::endl;
+    std::cout << "   -bwt               input_file contains the BWT of the input (terminated by the only 0-byte); the" << std::endl;
+    std::cout << "                      index is built from its runs without a suffix array (not for locate_rlzdsa" << std::endl;
+    std::cout << "                      and locate_hybrid)" << std::endl;
     std::cout << "   -o <base_name>     names the index file base_name.move-r (default: input_file)" << std::endl;
-    std::cout << "   -s <support>       support: count, locate_move or locate_rlzdsa" << std::endl;
-    std::cout << "                      (default: locate_move)" << std::endl;
+    std::cout << "   -s <support>       support: count, locate_one, locate_move, locate_rlzdsa or locate_hybrid" << std::endl;
+    std::cout << "                      (default: locate_move); for multiple comma-separated supports (e.g." << std::endl;
+    std::cout << "                      count,locate_move,locate_rlzdsa), the suffix array and the shared data" << std::endl;
+    std::cout << "                      structures are built only once and each index is written to" << std::endl;
+    std::cout << "                      base_name.<support>.move-r" << std::endl;
     std::cout << "   -p <integer>       number of threads to use during the construction of the index" << std::endl;
     std::cout << "                      (default: all threads)" << std::endl;
     std::cout << "   -a <integer>       balancing parameter; a must be an integer number and a >= 2 (default: 8)" << std::endl;
+    std::cout << "   -seed <integer>    seed for the random choices during the construction (default: 0)" << std::endl;
+    std::cout << "   -ref <ref_file>    build the rlzdsa relative to the reference stored in ref_file (only for" << std::endl;
+    std::cout << "                      locate_rlzdsa and locate_hybrid)" << std::endl;
+    std::cout << "   -ref_shared        store only the path to ref_file in the index instead of a copy of the reference" << std::endl;
+    std::cout << "   -calibrate         calibrate the minimum number of occurrences to use the rlzdsa by measuring query" << std::endl;
+    std::cout << "                      times (only for locate_hybrid; default: estimate it from n and r')" << std::endl;
+    std::cout << "   -export_ref <file> writes the reference of the rlzdsa to file, s.t. it can be used with -ref" << std::endl;
+    std::cout << "   -tune <patterns>   choose a, the sample rate of the rlzdsa and the maximum scan distance over L'," << std::endl;
+    std::cout << "                      s.t. queries for the patterns (in pizza&chili format) are answered the fastest;" << std::endl;
+    std::cout << "                      the input and the patterns are kept in memory during the whole tuning" << std::endl;
+    std::cout << "   -max_size <bytes>  memory budget for the index when using -tune (default: unlimited)" << std::endl;
+    std::cout << "   -max_mem <bytes>   memory budget for the construction; the construction mode and the number of" << std::endl;
+    std::cout << "                      threads are chosen s.t. the estimated peak memory usage fits (overrides -c)" << std::endl;
+    std::cout << "   -checkpoint <dir>  write the outputs of the expensive construction phases (SA or BWT, reference" << std::endl;
+    std::cout << "                      of the rlzdsa) to dir, s.t. an interrupted construction can be resumed" << std::endl;
+    std::cout << "   -resume            skip the phases completed in the checkpoint in dir (requires -checkpoint)" << std::endl;
+    std::cout << "   -keep_checkpoint   keep the checkpoint in dir after the construction has finished (requires" << std::endl;
+    std::cout << "                      -checkpoint)" << std::endl;
+    std::cout << "   -tmp <dir>         directory for the temporary files (default: the system's temporary directory)" << std::endl;
+    std::cout << "   -mmap              memory-map input_file instead of reading it into memory (not for -bwt and" << std::endl;
+    std::cout << "                      -tune)" << std::endl;
     std::cout << "   -m_idx <m_file>    m_file is file to write measurement data of the index construction to" << std::endl;
     std::cout << "   -m_mds <m_file>    m_file is file to write measurement data of the construction of the move" << std::endl;
     std::cout << "                      data structures to" << std::endl;
@@ -63,23 +116,39 @@ void parse_args(char** argv, int argc, int& ptr)
         std::string construction_mode_str = argv[ptr++];
 
         if (construction_mode_str == "sa") mode = _suffix_array;
-        else if (construction_mode_str == "bigbwt") mode = _bigbwt;
+        else if (construction_mode_str == "pfp" || construction_mode_str == "bigbwt") mode = _pfp;
         else help("error: invalid option for -c");
+    } else if (s == "-bwt") {
+        input_bwt = true;
     } else if (s == "-s") {
         if (ptr >= argc - 1)
             help("error: missing parameter after -s option");
 
-        std::string support_str = argv[ptr++];
-
-        if (support_str == "count") {
-            support = _count;
-        } else if (support_str == "locate_one") {
-            support = _locate_one;
-        } else if (support_str == "locate_move") {
-            support = _locate_move;
-        } else if (support_str == "locate_rlzdsa") {
-            support = _locate_rlzdsa;
-        } else help("error: unknown mode provided with -s option");
+        std::string supports_str = argv[ptr++];
+        std::stringstream supports_stream(supports_str);
+        std::string support_str;
+        supports.clear();
+
+        while (std::getline(supports_stream, support_str, ',')) {
+            move_r_support sup;
+
+            if (support_str == "count") {
+                sup = _count;
+            } else if (support_str == "locate_one") {
+                sup = _locate_one;
+            } else if (support_str == "locate_move") {
+                sup = _locate_move;
+            } else if (support_str == "locate_rlzdsa") {
+                sup = _locate_rlzdsa;
+            } else if (support_str == "locate_hybrid") {
+                sup = _locate_hybrid;
+            } else help("error: unknown mode provided with -s option");
+
+            if (!contains(supports, sup)) supports.emplace_back(sup);
+        }
+
+        if (supports.empty())
+            help("error: missing parameter after -s option");
     } else if (s == "-a") {
         if (ptr >= argc - 1)
             help("error: missing parameter after -a option");
@@ -88,6 +157,62 @@ void parse_args(char** argv, int argc, int& ptr)
 
         if (a < 2)
             help("error: a < 2");
+    } else if (s == "-seed") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -seed option");
+
+        seed = std::stoull(argv[ptr++]);
+    } else if (s == "-ref") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -ref option");
+
+        path_reference = argv[ptr++];
+
+        if (!std::filesystem::exists(path_reference))
+            help("error: cannot open reference file");
+    } else if (s == "-ref_shared") {
+        embed_reference = false;
+    } else if (s == "-calibrate") {
+        calibrate_min_occ = true;
+    } else if (s == "-export_ref") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -export_ref option");
+
+        path_export_reference = argv[ptr++];
+    } else if (s == "-tune") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -tune option");
+
+        path_tuning_patterns = argv[ptr++];
+
+        if (!std::filesystem::exists(path_tuning_patterns))
+            help("error: cannot open patterns file");
+    } else if (s == "-max_size") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -max_size option");
+
+        max_size_in_bytes = std::stoull(argv[ptr++]);
+    } else if (s == "-max_mem") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -max_mem option");
+
+        max_memory = std::stoull(argv[ptr++]);
+    } else if (s == "-checkpoint") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -checkpoint option");
+
+        checkpoint_dir = argv[ptr++];
+    } else if (s == "-resume") {
+        resume = true;
+    } else if (s == "-keep_checkpoint") {
+        keep_checkpoint = true;
+    } else if (s == "-tmp") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -tmp option");
+
+        tmp_dir = argv[ptr++];
+    } else if (s == "-mmap") {
+        use_mmap = true;
     } else if (s == "-m_idx") {
         if (ptr >= argc - 1)
             help("error: missing parameter after -m_idx option");
@@ -111,24 +236,137 @@ void parse_args(char** argv, int argc, int& ptr)
     }
 }
 
+template <typename pos_t>
+void read_rlbwt(std::string& run_heads, std::vector<pos_t>& run_lengths)
+{
+    uint64_t max_buf_size = std::max<uint64_t>(1, n / 500);
+    std::string buf;
+    no_init_resize(buf, max_buf_size);
+    uint64_t n_rem = n;
+
+    while (n_rem > 0) {
+        uint64_t cur_buf_size = std::min(n_rem, max_buf_size);
+        read_from_file(input_file, buf.c_str(), cur_buf_size);
+
+        for (uint64_t i = 0; i < cur_buf_size; i++) {
+            if (run_heads.empty() || buf[i] != run_heads.back()) {
+                run_heads.push_back(buf[i]);
+                run_lengths.push_back(1);
+            } else {
+                run_lengths.back()++;
+            }
+        }
+
+        n_rem -= cur_buf_size;
+    }
+}
+
+template <typename pos_t, move_r_support support, move_r_support new_support>
+void serialize_as(const move_r<support, char, pos_t>& index)
+{
+    if constexpr (requires { index.template downgrade_to<new_support>(p); }) {
+        std::string path = path_prefix_index_file + "." + support_name(new_support) + ".move-r";
+        std::cout << "serializing the index with support " << support_name(new_support) << " to " << path << std::flush;
+        auto time = now();
+        std::ofstream file(path);
+        index.template downgrade_to<new_support>(p).serialize(file);
+        file.close();
+        log_runtime(time);
+    }
+}
+
 template <typename pos_t, move_r_support support>
 void build()
 {
-    move_r<support, char, pos_t> index(input_file, {
+    move_r_params params = {
         .mode = mode,
         .num_threads = p,
         .a = a,
         .log = true,
         .mf_idx = mf_idx.is_open() ? &mf_idx : NULL,
         .mf_mds = mf_mds.is_open() ? &mf_mds : NULL,
-        .name_text_file = name_text_file
-    });
+        .name_text_file = name_text_file,
+        .seed = seed,
+        .path_reference = path_reference,
+        .embed_reference = embed_reference,
+        .calibrate_min_occ = calibrate_min_occ,
+        .max_memory = max_memory,
+        .checkpoint_dir = checkpoint_dir,
+        .resume = resume,
+        .keep_checkpoint = keep_checkpoint,
+        .tmp_dir = tmp_dir
+    };
+
+    move_r<support, char, pos_t> index;
+
+    if (input_bwt) {
+        if constexpr (support != _locate_rlzdsa && support != _locate_hybrid) {
+            std::string run_heads;
+            std::vector<pos_t> run_lengths;
+            read_rlbwt<pos_t>(run_heads, run_lengths);
+            index = move_r<support, char, pos_t>(run_heads, run_lengths, params);
+        }
+    } else if (path_tuning_patterns == "") {
+        if (use_mmap) {
+            index = move_r<support, char, pos_t>(std::filesystem::path(path_input_file), params);
+        } else {
+            index = move_r<support, char, pos_t>(input_file, params);
+        }
+    } else {
+        std::string input;
+        no_init_resize(input, n - 1);
+        read_from_file(input_file, input.c_str(), n - 1);
+
+        std::ifstream patterns_file(path_tuning_patterns);
+        std::string header;
+        std::getline(patterns_file, header);
+        uint64_t num_patterns = number_of_patterns(header);
+        uint64_t pattern_length = patterns_length(header);
+        std::vector<std::string> patterns(num_patterns);
+
+        for (uint64_t i = 0; i < num_patterns; i++) {
+            no_init_resize(patterns[i], pattern_length);
+            patterns_file.read((char*)&patterns[i][0], pattern_length);
+        }
+
+        patterns_file.close();
+        index = move_r<support, char, pos_t>(input, patterns, { .max_size_in_bytes = max_size_in_bytes }, params);
+    }
 
     input_file.close();
-    std::cout << "serializing the index" << std::flush;
+
+    if (supports.size() == 1) {
+        std::cout << "serializing the index" << std::flush;
+        auto time = now();
+        index.serialize(index_file);
+        log_runtime(time);
+    } else {
+        for (move_r_support sup : supports) {
+            if (sup == _count) {
+                serialize_as<pos_t, support, _count>(index);
+            } else if (sup == _locate_one) {
+                serialize_as<pos_t, support, _locate_one>(index);
+            } else if (sup == _locate_move) {
+                serialize_as<pos_t, support, _locate_move>(index);
+            } else if (sup == _locate_rlzdsa) {
+                serialize_as<pos_t, support, _locate_rlzdsa>(index);
+            } else {
+                serialize_as<pos_t, support, _locate_hybrid>(index);
+            }
+        }
+    }
+
     auto time = now();
-    index.serialize(index_file);
-    log_runtime(time);
+
+    if constexpr (support == _locate_rlzdsa || support == _locate_hybrid) {
+        if (path_export_reference != "") {
+            std::cout << "exporting the reference to " << path_export_reference << std::flush;
+            std::ofstream reference_file(path_export_reference);
+            index.export_reference(reference_file, p);
+            reference_file.close();
+            log_runtime(time);
+        }
+    }
 }
 
 int main(int argc, char** argv)
@@ -141,26 +379,43 @@ int main(int argc, char** argv)
     if (path_prefix_index_file == "")
         path_prefix_index_file = path_input_file;
 
+    // build the index with the support covering all requested supports and derive the requested supports from it
+    bool needs_m_phi_m1 = contains(supports, _locate_move) || contains(supports, _locate_hybrid);
+    bool needs_rlzdsa = contains(supports, _locate_rlzdsa) || contains(supports, _locate_hybrid);
+
+    if (needs_m_phi_m1 && needs_rlzdsa) support = _locate_hybrid;
+    else if (needs_m_phi_m1) support = _locate_move;
+    else if (needs_rlzdsa) support = _locate_rlzdsa;
+    else if (contains(supports, _locate_one)) support = _locate_one;
+    else support = _count;
+
     std::cout << std::setprecision(4);
     name_text_file = path_input_file.substr(path_input_file.find_last_of("/\\") + 1);
-    path_index_file = path_prefix_index_file.append(".move-r");
+    path_index_file = path_prefix_index_file + ".move-r";
 
     std::cout << "building move-r of " << path_input_file;
     std::cout << " using " << format_threads(p) << " and a = " << a << std::endl;
-    std::cout << "the index will be saved to " << path_index_file << std::endl
-              << std::endl;
+
+    if (supports.size() == 1) {
+        std::cout << "the index will be saved to " << path_index_file << std::endl
+                  << std::endl;
+    } else {
+        std::cout << "the indexes will be saved to " << path_prefix_index_file << ".<support>.move-r" << std::endl
+                  << std::endl;
+    }
 
     input_file.open(path_input_file);
-    index_file.open(path_index_file);
+    if (supports.size() == 1) index_file.open(path_index_file);
 
     if (!input_file.good())
         help("error: invalid input, could not read <input_file>");
-    if (!index_file.good())
+    if (supports.size() == 1 && !index_file.good())
         help("error: invalid input, could not create <index_file>");
 
     input_file.seekg(0, std::ios::end);
     n = input_file.tellg() + (std::streamsize) + 1;
     input_file.seekg(0, std::ios::beg);
+    if (input_bwt) n--;
 
     if (p > 1 && 1000 * p > n) {
         p = std::max<uint16_t>(1, n / 1000);
@@ -169,6 +424,27 @@ int main(int argc, char** argv)
         p = std::max<uint16_t>(1, std::min<uint64_t>({ omp_get_max_threads(), n / 1000, p }));
     }
 
+    if (input_bwt && (support == _locate_rlzdsa || support == _locate_hybrid || path_tuning_patterns != ""))
+        help("error: -bwt cannot be used with -s locate_rlzdsa, -s locate_hybrid or -tune");
+
+    if (resume && checkpoint_dir == "")
+        help("error: -resume requires -checkpoint");
+
+    if (keep_checkpoint && checkpoint_dir == "")
+        help("error: -keep_checkpoint requires -checkpoint");
+
+    if (use_mmap && (input_bwt || path_tuning_patterns != ""))
+        help("error: -mmap cannot be used with -bwt or -tune");
+
+    if (supports.size() > 1 && path_tuning_patterns != "")
+        help("error: -tune cannot be used with multiple supports");
+
+    if ((path_reference != "" || path_export_reference != "") && support != _locate_rlzdsa && support != _locate_hybrid)
+        help("error: -ref and -export_ref require -s locate_rlzdsa or -s locate_hybrid");
+
+    if (calibrate_min_occ && support != _locate_hybrid)
+        help("error: -calibrate requires -s locate_hybrid");
+
     if (mf_idx.is_open()) {
         mf_idx << "RESULT"
                << " type=build_index"
@@ -183,24 +459,37 @@ int main(int argc, char** argv)
         } else {
             build<uint64_t, _count>();
         }
+    } else if (support == _locate_one) {
+        if (n < UINT_MAX) {
+            build<uint32_t, _locate_one>();
+        } else {
+            build<uint64_t, _locate_one>();
+        }
     } else if (support == _locate_move) {
         if (n < UINT_MAX) {
             build<uint32_t, _locate_move>();
         } else {
             build<uint64_t, _locate_move>();
         }
-    } else {
+    } else if (support == _locate_rlzdsa) {
         if (n < UINT_MAX) {
             build<uint32_t, _locate_rlzdsa>();
         } else {
             build<uint64_t, _locate_rlzdsa>();
         }
+    } else {
+        if (n < UINT_MAX) {
+            build<uint32_t, _locate_hybrid>();
+        } else {
+            build<uint64_t, _locate_hybrid>();
+        }
     }
 
     if (mf_idx.is_open())
         mf_idx.close();
     if (mf_mds.is_open())
         mf_mds.close();
-        
-    index_file.close();
+
+    if (index_file.is_open())
+        index_file.close();
 }
\ No newline at end of file
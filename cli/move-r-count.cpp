@@ -108,9 +108,11 @@ void measure_count()
         mf << " r_=" << index.M_LF().num_intervals();
 
         if constexpr (support != _count && support != _locate_one) {
-            if constexpr (support == _locate_move) {
+            if constexpr (support == _locate_move || support == _locate_hybrid) {
                 mf << " r__=" << index.M_Phi_m1().num_intervals();
-            } else if constexpr (support == _locate_rlzdsa) {
+            }
+
+            if constexpr (support == _locate_rlzdsa || support == _locate_hybrid) {
                 mf << " z__=" << index.num_phrases_rlzdsa();
                 mf << " z_l_=" << index.num_literal_phrases_rlzdsa();
                 mf << " z_c_=" << index.num_copy_phrases_rlzdsa();
@@ -145,11 +147,7 @@ int main(int argc, char** argv)
     if (!patterns_file.good())
         help("error: could not read <patterns_file>");
 
-    bool is_64_bit;
-    index_file.read((char*)&is_64_bit, 1);
-    move_r_support _support;
-    index_file.read((char*)&_support, sizeof(move_r_support));
-    index_file.seekg(0, std::ios::beg);
+    auto [is_64_bit, _support] = read_index_type(index_file);
 
     if (_support == _count) {
         if (is_64_bit) {
@@ -169,11 +167,17 @@ int main(int argc, char** argv)
         } else {
             measure_count<uint32_t, _locate_move>();
         }
-    } else {
+    } else if (_support == _locate_rlzdsa) {
         if (is_64_bit) {
             measure_count<uint64_t, _locate_rlzdsa>();
         } else {
             measure_count<uint32_t, _locate_rlzdsa>();
         }
+    } else {
+        if (is_64_bit) {
+            measure_count<uint64_t, _locate_hybrid>();
+        } else {
+            measure_count<uint32_t, _locate_hybrid>();
+        }
     }
 }
\ No newline at end of file
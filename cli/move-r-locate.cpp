@@ -187,9 +187,11 @@ void measure_locate()
         mf << " r=" << index.num_bwt_runs();
         mf << " r_=" << index.M_LF().num_intervals();
 
-        if constexpr (support == _locate_move) {
+        if constexpr (support == _locate_move || support == _locate_hybrid) {
             mf << " r__=" << index.M_Phi_m1().num_intervals();
-        } else if constexpr (support == _locate_rlzdsa) {
+        }
+
+        if constexpr (support == _locate_rlzdsa || support == _locate_hybrid) {
             mf << " z__=" << index.num_phrases_rlzdsa();
             mf << " z_l_=" << index.num_literal_phrases_rlzdsa();
             mf << " z_c_=" << index.num_copy_phrases_rlzdsa();
@@ -235,11 +237,7 @@ int main(int argc, char** argv)
             help("error: could not read <input_file>");
     }
 
-    bool is_64_bit;
-    index_file.read((char*)&is_64_bit, 1);
-    move_r_support _support;
-    index_file.read((char*)&_support, sizeof(move_r_support));
-    index_file.seekg(0, std::ios::beg);
+    auto [is_64_bit, _support] = read_index_type(index_file);
 
     if (_support == _count || _support == _locate_one) {
         std::cout << "error: this index does not support locate" << std::endl;
@@ -250,12 +248,18 @@ int main(int argc, char** argv)
         } else {
             measure_locate<uint32_t, _locate_move>();
         }
-    } else {
+    } else if (_support == _locate_rlzdsa) {
         if (is_64_bit) {
             measure_locate<uint64_t, _locate_rlzdsa>();
         } else {
             measure_locate<uint32_t, _locate_rlzdsa>();
         }
+    } else {
+        if (is_64_bit) {
+            measure_locate<uint64_t, _locate_hybrid>();
+        } else {
+            measure_locate<uint32_t, _locate_hybrid>();
+        }
     }
 
     patterns_file.close();
@@ -4,7 +4,9 @@
 
 int ptr = 1;
 uint16_t p = 1;
+uint8_t k = 1;
 bool revert_in_memory = false;
+bool revert_forward = false;
 std::string path_index_file;
 std::string path_outputfile;
 std::string name_text_file;
@@ -21,6 +23,11 @@ void help(std::string msg)
     std::cout << "                              output in memory" << std::endl;
     std::cout << "   -p <integer>               number of threads to use while reverting" << std::endl;
     std::cout << "                              (default: greatest possible)" << std::endl;
+    std::cout << "   -k <integer>               number of LF-steps to perform per move-query (rounded" << std::endl;
+    std::cout << "                              down to a power of two); builds M_LF^k before" << std::endl;
+    std::cout << "                              reverting (default: 1)" << std::endl;
+    std::cout << "   -f                         builds M_FL before reverting and reverts the index" << std::endl;
+    std::cout << "                              from left to right (ignores -k)" << std::endl;
     std::cout << "   -m <m_file> <text_name>    m_file is the file to write measurement data to," << std::endl;
     std::cout << "                              text_name should be the name of the original file" << std::endl;
     std::cout << "   <index_file>               index file (with extension .move-r)" << std::endl;
@@ -57,6 +64,21 @@ void parse_args(char** argv, int argc, int& ptr)
 
         if (p > omp_get_max_threads())
             help("error: p > number of available threads");
+    } else if (s == "-f") {
+        revert_forward = true;
+    } else if (s == "-k") {
+        if (ptr >= argc - 1)
+            help("error: missing parameter after -k option");
+
+        int k_arg = atoi(argv[ptr++]);
+
+        if (k_arg < 1)
+            help("error: k < 1");
+
+        if (k_arg > 128)
+            help("error: k > 128");
+
+        k = k_arg;
     } else {
         help("error: unrecognized '" + s + "' option");
     }
@@ -72,17 +94,43 @@ void measure_revert()
     index.load(index_file);
     log_runtime(t1);
     index_file.close();
+    std::chrono::steady_clock::time_point t2, t3, t4;
+    std::string input;
+    uint64_t time_build_m_lf_k = 0;
+    uint64_t time_build_m_fl = 0;
+
+    if (revert_forward) {
+        std::cout << "building M_FL" << std::flush;
+        t2 = now();
+        index.build_m_fl(std::min<uint16_t>(omp_get_max_threads(), p));
+        t3 = now();
+        time_build_m_fl = time_diff_ns(t2, t3);
+        log_runtime(t2, t3);
+    } else if (k > 1) {
+        std::cout << "building M_LF^" << std::to_string(k) << std::flush;
+        t2 = now();
+        index.build_m_lf_k(k, std::min<uint16_t>(omp_get_max_threads(), p));
+        t3 = now();
+        time_build_m_lf_k = time_diff_ns(t2, t3);
+        log_runtime(t2, t3);
+    }
+
     std::cout << std::endl;
     index.log_data_structure_sizes();
     std::cout << std::endl;
-    std::chrono::steady_clock::time_point t2, t3, t4;
-    std::string input;
     p = std::min({ (uint16_t)omp_get_max_threads(), index.max_revert_threads(), p });
 
     if (revert_in_memory) {
         std::cout << "reverting the index in memory using " << format_threads(p) << std::flush;
         t2 = now();
-        input = index.revert({ .num_threads = p });
+
+        if (revert_forward) {
+            no_init_resize(input, index.input_size());
+            index.revert_forward([&input](pos_t i, char c) { input[i] = c; }, { .num_threads = p });
+        } else {
+            input = index.revert({ .num_threads = p });
+        }
+
         t3 = now();
         log_runtime(t2, t3);
         std::cout << "writing the input to the file " << std::flush;
@@ -109,11 +157,24 @@ void measure_revert()
         mf << " sigma=" << std::to_string(index.alphabet_size());
         mf << " r=" << index.num_bwt_runs();
         mf << " r_=" << index.M_LF().num_intervals();
+        mf << " k=" << std::to_string(index.lf_steps());
+
+        if (index.lf_steps() > 1) {
+            mf << " r_k_=" << index.M_LF_k().num_intervals();
+            mf << " time_build_m_lf_k=" << time_build_m_lf_k;
+        }
+
+        if (index.has_m_fl()) {
+            mf << " r_fl_=" << index.M_FL().num_intervals();
+            mf << " time_build_m_fl=" << time_build_m_fl;
+        }
 
         if constexpr (support != _count && support != _locate_one) {
-            if constexpr (support == _locate_move) {
+            if constexpr (support == _locate_move || support == _locate_hybrid) {
                 mf << " r__=" << index.M_Phi_m1().num_intervals();
-            } else if constexpr (support == _locate_rlzdsa) {
+            }
+
+            if constexpr (support == _locate_rlzdsa || support == _locate_hybrid) {
                 mf << " z__=" << index.num_phrases_rlzdsa();
                 mf << " z_l_=" << index.num_literal_phrases_rlzdsa();
                 mf << " z_c_=" << index.num_copy_phrases_rlzdsa();
@@ -146,11 +207,7 @@ int main(int argc, char** argv)
     if (!output_file.good())
         help("error: could not create <output_file>");
 
-    bool is_64_bit;
-    index_file.read((char*)&is_64_bit, 1);
-    move_r_support _support;
-    index_file.read((char*)&_support, sizeof(move_r_support));
-    index_file.seekg(0, std::ios::beg);
+    auto [is_64_bit, _support] = read_index_type(index_file);
 
     if (_support == _count) {
         if (is_64_bit) {
@@ -170,12 +227,18 @@ int main(int argc, char** argv)
         } else {
             measure_revert<uint32_t, _locate_move>();
         }
-    } else {
+    } else if (_support == _locate_rlzdsa) {
         if (is_64_bit) {
             measure_revert<uint64_t, _locate_rlzdsa>();
         } else {
             measure_revert<uint32_t, _locate_rlzdsa>();
         }
+    } else {
+        if (is_64_bit) {
+            measure_revert<uint64_t, _locate_hybrid>();
+        } else {
+            measure_revert<uint32_t, _locate_hybrid>();
+        }
     }
 
     output_file.close();
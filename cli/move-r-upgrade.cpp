@@ -0,0 +1,122 @@
+#include <filesystem>
+#include <iostream>
+#include <move_r/move_r.hpp>
+
+int ptr = 1;
+uint16_t p = omp_get_max_threads();
+move_r_support support = _locate_move;
+std::string path_index_file;
+std::string path_output_file;
+std::ifstream index_file;
+std::ofstream output_file;
+
+void help(std::string msg)
+{
+    if (msg != "") std::cout << msg << std::endl;
+    std::cout << "move-r-upgrade: adds locate support to a count-only index without rebuilding it." << std::endl << std::endl;
+    std::cout << "usage: move-r-upgrade [options] <index_file> <output_file>" << std::endl;
+    std::cout << "   -s <support>       support of the upgraded index: locate_one or locate_move" << std::endl;
+    std::cout << "                      (default: locate_move)" << std::endl;
+    std::cout << "   -p <integer>       number of threads to use (default: all threads)" << std::endl;
+    std::cout << "   <index_file>       index file of a count-only index (with extension .move-r)" << std::endl;
+    std::cout << "   <output_file>      file to write the upgraded index to" << std::endl;
+    exit(0);
+}
+
+void parse_args(char** argv, int argc, int& ptr)
+{
+    std::string s = argv[ptr];
+    ptr++;
+
+    if (s == "-s") {
+        if (ptr >= argc - 2)
+            help("error: missing parameter after -s option");
+
+        std::string support_str = argv[ptr++];
+
+        if (support_str == "locate_one") {
+            support = _locate_one;
+        } else if (support_str == "locate_move") {
+            support = _locate_move;
+        } else help("error: unknown mode provided with -s option");
+    } else if (s == "-p") {
+        if (ptr >= argc - 2)
+            help("error: missing parameter after -p option");
+
+        p = atoi(argv[ptr++]);
+
+        if (p < 1)
+            help("error: p < 1");
+        if (p > omp_get_max_threads())
+            help("error: p > maximum number of threads");
+    } else {
+        help("error: unrecognized '" + s + "' option");
+    }
+}
+
+template <typename pos_t, move_r_support new_support>
+void upgrade()
+{
+    std::cout << "loading the index" << std::flush;
+    auto time = now();
+    move_r<_count, char, pos_t> index;
+    index.load(index_file);
+    index_file.close();
+    time = log_runtime(time);
+    std::cout << std::endl;
+
+    move_r<new_support, char, pos_t> index_upgraded = index.template upgrade_to<new_support>(p, true);
+    index = move_r<_count, char, pos_t>();
+
+    std::cout << std::endl << "serializing the index" << std::flush;
+    time = now();
+    index_upgraded.serialize(output_file);
+    log_runtime(time);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+        help("");
+
+    while (ptr < argc - 2)
+        parse_args(argv, argc, ptr);
+
+    path_index_file = argv[ptr];
+    path_output_file = argv[ptr + 1];
+
+    index_file.open(path_index_file);
+
+    if (!index_file.good())
+        help("error: could not read <index_file>");
+
+    auto [is_64_bit, _support] = read_index_type(index_file);
+
+    if (_support != _count)
+        help("error: <index_file> does not contain a count-only index");
+
+    output_file.open(path_output_file);
+
+    if (!output_file.good())
+        help("error: could not create <output_file>");
+
+    std::cout << std::setprecision(4);
+    std::cout << "upgrading the index " << path_index_file << " using " << format_threads(p) << std::endl;
+    std::cout << "the upgraded index will be saved to " << path_output_file << std::endl << std::endl;
+
+    if (support == _locate_one) {
+        if (is_64_bit) {
+            upgrade<uint64_t, _locate_one>();
+        } else {
+            upgrade<uint32_t, _locate_one>();
+        }
+    } else {
+        if (is_64_bit) {
+            upgrade<uint64_t, _locate_move>();
+        } else {
+            upgrade<uint32_t, _locate_move>();
+        }
+    }
+
+    output_file.close();
+}
\ No newline at end of file
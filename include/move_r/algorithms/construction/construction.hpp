@@ -1,16 +1,23 @@
 #pragma once
 
+#include <condition_variable>
+#include <fcntl.h>
 #include <gtl/btree.hpp>
 #include <hash_table5.hpp>
 #include <move_r/move_r.hpp>
+#include <mutex>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
 
 enum rlbwt_build_mode {
     _sa, // the BWT is read by L[i] = T[(SA[i]-1) mod n]
-    _bwt, // the BWT is read by accessing L[i]
-    _bwt_file // the BWT is read from files output by Big-BWT
+    _bwt // the BWT is read by accessing L[i]
 };
 
 template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
 class move_r<support, sym_t, pos_t>::construction {
 public:
     construction() = delete;
@@ -18,7 +25,55 @@ public:
     construction(const construction&) = delete;
     construction& operator=(construction&&) = delete;
     construction& operator=(const construction&) = delete;
-    ~construction() { }
+
+    /**
+     * @brief a directory that is removed (including its contents) when the object is destroyed; since the members of
+     * the construction are also destroyed if its constructor throws an exception, the temporary files are never left behind
+     */
+    struct tmp_dir_guard {
+        std::filesystem::path path; // the directory (empty <=> no directory)
+
+        tmp_dir_guard() = default;
+        tmp_dir_guard(const tmp_dir_guard&) = delete;
+        tmp_dir_guard& operator=(const tmp_dir_guard&) = delete;
+
+        ~tmp_dir_guard()
+        {
+            if (!path.empty()) {
+                std::error_code ec;
+                std::filesystem::remove_all(path, ec);
+            }
+        }
+    };
+
+    /**
+     * @brief a memory mapping that is unmapped when the object is destroyed
+     */
+    struct mmap_guard {
+        char* data = NULL; // start of the mapping (NULL <=> nothing is mapped)
+        uint64_t size = 0; // size of the mapping in bytes
+
+        mmap_guard() = default;
+        mmap_guard(const mmap_guard&) = delete;
+        mmap_guard& operator=(const mmap_guard&) = delete;
+
+        ~mmap_guard()
+        {
+            unmap();
+        }
+
+        /**
+         * @brief unmaps the mapping, if there is one
+         */
+        void unmap()
+        {
+            if (data != NULL) {
+                munmap(data, size);
+                data = NULL;
+                size = 0;
+            }
+        }
+    };
 
     // ############################# MISC VARIABLES #############################
 
@@ -39,11 +94,13 @@ public:
     std::ostream* mf_idx = NULL; // file to write measurement data of the index construction to
     std::ostream* mf_mds = NULL; // file to write measurement data of the move data structure construction to
     std::string name_text_file = ""; // name of the text file (only for measurement output)
+    std::string tmp_dir = ""; // directory to create the directory for the temporary files in (empty <=> the system's temporary directory)
+    tmp_dir_guard dir_tmp_files; // directory of the temporary files of this construction
     std::string prefix_tmp_files = ""; // prefix of temporary files
     std::chrono::steady_clock::time_point time; // time of the start of the last build phase
     std::chrono::steady_clock::time_point time_start; // time of the start of the whole build phase
     uint64_t baseline_mem_usage = 0; // memory allocation at the start of the construction
-    uint64_t bigbwt_peak_mem_usage = 0; // peak memory usage during the execution of Big-BWT
+    uint64_t baseline_peak_mem_usage = 0; // peak memory allocation of the process at the start of the construction
     uint8_t min_valid_char = 0; // the minimum valid character that is allowed to occur in T
     uint8_t max_remapped_uchar = 0; // the maximum character in T that has been remapped
     uint8_t max_remapped_to_uchar = 0; // the maximum character in the effective alphabet of T that a character has been remapped to
@@ -51,6 +108,20 @@ public:
     pos_t size_R_target = 0; // target size for R
     pos_t seg_size = 0; // (maximum) size of each segment from SA^d to be included in R
     pos_t num_cand_segs = 0; // number of candidate segments that are considered in each iteration during the construction of R
+    /* minimum score (relative to the best score) of a candidate segment to be selected in the same round as the best candidate
+     * segment during the construction of R */
+    static constexpr float min_rel_score_round = 0.75;
+    uint64_t seed = 0; // seed for the random number generators used during the construction
+    std::string path_reference = ""; // file storing the reference for the rlzdsa (empty <=> R is built)
+    bool embed_reference = true; // controls, whether R is stored in the index or whether only path_reference is stored
+    bool calibrate_min_occ = false; // controls, whether to calibrate the minimum number of occurrences to use the rlzdsa
+    uint64_t n_R = 0; // length of the input the reference (R) of the rlzdsa has been built for
+    uint64_t max_memory = 0; // memory budget for the construction in bytes (0 <=> no budget)
+    std::string checkpoint_dir = ""; // directory to write checkpoints of the completed phases to (empty <=> no checkpoints)
+    bool resume = false; // controls, whether to skip the phases that have been completed in the checkpoint in checkpoint_dir
+    bool keep_checkpoint = false; // controls, whether to keep the checkpoint after the construction has finished
+    uint64_t fingerprint_t = 0; // fingerprint of T that identifies the input of a checkpoint
+    std::string path_sa_file = ""; // path of the suffix array file written during prefix-free parsing
 
     // ############################# INDEX VARIABLES #############################
 
@@ -64,6 +135,8 @@ public:
 
     /** the string containing T */
     std::string& T_str;
+    /** memory mapping of the input file containing T (T_mmap.data = NULL <=> T is stored in T_str or T_vec) */
+    mmap_guard T_mmap;
     /** the vector containing T */
     std::vector<sym_t>& T_vec;
     /** The move-r index to construct */
@@ -74,8 +147,6 @@ public:
     std::vector<int64_t>& SA_64;
     /** [0..n-1] The BWT */
     std::string& L;
-    /** [0..p-1] file buffers (of each thread) for reading the BWT file output by bigbwt */
-    std::vector<sdsl::int_vector_buffer<8>> BWT_file_bufs;
     /** [0..p-1] vectors that contain the RLBWT concatenated */
     std::vector<interleaved_vectors<uint32_t, uint32_t>> RLBWT;
     /** [0..p] n_p[0] < n_p[1] < ... < n_p[p] = n; n_p[i] = start position of thread i's section in L and SA */
@@ -83,21 +154,55 @@ public:
     /** [0..p] r_p[0] < r_p[1] < ... < r_p[p] = r; r_p[i] = index of the first run in L starting in
      * [n_p[i]..n_p[i+1]-1]; there is a run starting at n_p[i] */
     std::vector<pos_t> r_p;
-    /** [0..p][0..255] see the code to see how this variable is used */
+    /** [0..p][0..255] see the code to see how this variable is used (only for byte alphabets) */
     std::vector<std::vector<pos_t>> C;
     /** The disjoint interval sequence for LF */
-    std::vector<std::pair<pos_t, pos_t>> I_LF;
+    std::vector<std::pair<pck_t, pck_t>> I_LF;
     /** The disjoint interval sequence for Phi^{-1} */
-    std::vector<std::pair<pos_t, pos_t>> I_Phi_m1;
+    std::vector<std::pair<pck_t, pck_t>> I_Phi_m1;
     /** [0..r'-1] SA_s[x] = SA[M_LF.p[x]]; if the starting position of the
      * x-th input interval of M_LF is not starting position of a BWT run, then SA_s[x] = n */
-    std::vector<pos_t> SA_s;
-    /** [0..r'-1] Permutation storing the order of the values in SA_s */
-    std::vector<pos_t> pi_;
+    std::vector<pck_t> SA_s;
+    /** [0..r'-1] Permutation storing the order of the values in SA_s (it stores interval indices, which are packed
+     * like in the construction of the move data structures) */
+    std::vector<packed_t<pos_t>> pi_;
     /** [0..r''-1] Permutation storing the order of the output interval starting positions of M_Phi^{-1} */
-    std::vector<pos_t> pi_mphi;
-    /** [0..p-1] file buffers (of each thread) for reading the suffix array file output by bigbwt */
+    std::vector<packed_t<pos_t>> pi_mphi;
+    /** [0..p-1] file buffers (of each thread) for reading the suffix array file written during prefix-free parsing */
     std::vector<sdsl::int_vector_buffer<40>> SA_file_bufs;
+    /** [0..r] P_r[k] = starting position of the k-th BWT run, P_r[r] = n (only used for rebalancing) */
+    std::vector<pos_t> P_r;
+    /** [0..r-1] L_r[k] = symbol of the k-th BWT run (only used for rebalancing) */
+    std::vector<i_sym_t> L_r;
+    /** [0..r-1] SA_r[k] = SA[P_r[k]] (only used for rebalancing) */
+    std::vector<pos_t> SA_r;
+    /** the files of the completed phases in the checkpoint, stored as triples (phase,file name,file size) */
+    std::vector<std::tuple<std::string, std::string, uint64_t>> checkpoint_files;
+
+    // ############################# PREFIX-FREE PARSING VARIABLES #############################
+
+    static constexpr uint64_t prime_pfp = 1999999973; // prime modulus of the Karp-Rabin fingerprints of the windows
+    static constexpr uint64_t m_pfp = 100; // a window is a trigger string <=> its fingerprint is divisible by m_pfp
+    pos_t w_pfp = 10; // window size
+    pos_t k_pfp = 0; // number of phrases in the parse
+    /** the 0-th phrase of the parse; it starts with T[n-w..n-1] and continues with T[0..] */
+    std::string phrase_0;
+    /** [0..k-1] S_pfp[j] = starting position of the j-th phrase in T (S_pfp[0] = n-w) */
+    std::vector<pos_t> S_pfp;
+    /** [0..k-1] P_pfp[j] = lexicographic rank of the j-th phrase among the distinct phrases (the parse) */
+    std::vector<pos_t> P_pfp;
+    /** [0..|D|-1] the distinct phrases (the dictionary) in lexicographic order */
+    std::vector<std::string_view> D_pfp;
+    /** [0..k-1] SA_P_pfp[q] = index of the phrase preceding the q-th smallest rotation of the parse */
+    std::vector<pos_t> SA_P_pfp;
+    /** [0..k-1] inverted lists; IL_pfp[IL_b_pfp[d]..IL_b_pfp[d+1]-1] are the positions in the BWT of the parse storing d */
+    std::vector<pos_t> IL_pfp;
+    /** [0..|D|] starting positions of the inverted lists in IL_pfp */
+    std::vector<pos_t> IL_b_pfp;
+    /** pairs (d,o) in lexicographic order of the suffixes D_pfp[d][o..] of length > w of the phrases */
+    std::vector<std::pair<pos_t, pos_t>> V_pfp;
+    /** starting positions of the groups of equal suffixes in V_pfp (and |V_pfp|) */
+    std::vector<pos_t> G_pfp;
 
     /** type of hash map for storing the frequencies of values in SA^d */
     template <typename sad_t>
@@ -196,6 +301,7 @@ public:
     inline type& T(pos_t i)
     {
         if constexpr (str_input) {
+            if (T_mmap.data != NULL) return *reinterpret_cast<type*>(&T_mmap.data[i]);
             return *reinterpret_cast<type*>(&T_str[i]);
         } else {
             return *reinterpret_cast<type*>(&T_vec[i]);
@@ -285,18 +391,43 @@ public:
         }
     }
 
+    // ############################# PREFIX-FREE PARSING MISC METHODS #############################
+
+    /**
+     * @brief returns the length of the j-th phrase
+     * @param j [0..k-1] phrase index
+     * @return phrase length
+     */
+    inline pos_t phrase_len(pos_t j)
+    {
+        if (j == 0) return k_pfp == 1 ? n + w_pfp : S_pfp[1] + 2 * w_pfp;
+        if (j == k_pfp - 1) return n - S_pfp[j];
+        return S_pfp[j + 1] - S_pfp[j] + w_pfp;
+    }
+
+    /**
+     * @brief returns the j-th phrase
+     * @param j [0..k-1] phrase index
+     * @return phrase
+     */
+    inline std::string_view phrase(pos_t j)
+    {
+        if (j == 0) return phrase_0;
+        return std::string_view(&T<char>(S_pfp[j]), phrase_len(j));
+    }
+
     // ############################# rlzdsa MISC METHODS #############################
 
     /**
      * @brief returns SA[i]
-     * @tparam bigbwt true <=> read SA[i] from SA_file
+     * @tparam sa_file true <=> read SA[i] from SA_file
      * @tparam sa_sint_t suffix array signed integer type
      * @return SA[i]
      */
-    template <bool bigbwt, typename sa_sint_t>
+    template <bool sa_file, typename sa_sint_t>
     inline pos_t SA(uint16_t i_p, pos_t i)
     {
-        if constexpr (bigbwt) {
+        if constexpr (sa_file) {
             if (i == 0)
                 return n - 1;
             return pos_t { SA_file_bufs[i_p][i - 1] };
@@ -307,14 +438,14 @@ public:
 
     /**
      * @brief returns SA^d[i]
-     * @tparam bigbwt true <=> read SA[i] and SA[i-1] from SA_file
+     * @tparam sa_file true <=> read SA[i] and SA[i-1] from SA_file
      * @tparam sa_sint_t suffix array signed integer type
      * @return SA^d[i]
      */
-    template <bool bigbwt, typename sa_sint_t>
+    template <bool sa_file, typename sa_sint_t>
     inline uint64_t SAd(uint16_t i_p, pos_t i)
     {
-        if constexpr (bigbwt) {
+        if constexpr (sa_file) {
             if (i <= 1) {
                 if (i == 0)
                     return n_u64 - 1;
@@ -326,6 +457,29 @@ public:
         }
     }
 
+    /**
+     * @brief returns SA^d[i] shifted to the value range of R, i.e., SA^d[i]-n+n_R; if the shifted value does not lie in
+     *        [0,2*n_R), then it cannot occur in R, and the maximum value of uint64_t is returned instead
+     * @tparam sa_file true <=> read SA[i] and SA[i-1] from SA_file
+     * @tparam sa_sint_t suffix array signed integer type
+     * @return SA^d[i]-n+n_R
+     */
+    template <bool sa_file, typename sa_sint_t>
+    inline uint64_t SAd_R(uint16_t i_p, pos_t i)
+    {
+        uint64_t sad = SAd<sa_file, sa_sint_t>(i_p, i);
+
+        if (n_R == n_u64) [[likely]] {
+            return sad;
+        }
+
+        if (sad + n_R < n_u64 || sad + n_R - n_u64 >= 2 * n_R) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+
+        return sad + n_R - n_u64;
+    }
+
     /**
      * @brief returns SAd_freq
      * @tparam sad_t type of the values in SA^d
@@ -452,11 +606,14 @@ public:
     {
         time = now();
         time_start = time;
-        omp_set_num_threads(p);
-        prefix_tmp_files = std::filesystem::temp_directory_path().string() +
-            "/move-r_" + random_alphanumeric_string(10);
-        baseline_mem_usage = malloc_count_current();
-        if (log) malloc_count_reset_peak();
+        // each construction writes its temporary files to its own directory, s.t. concurrent constructions do not interfere
+        dir_tmp_files.path = (tmp_dir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(tmp_dir)) /
+            ("move-r_" + random_alphanumeric_string(16));
+        std::filesystem::create_directories(dir_tmp_files.path);
+        prefix_tmp_files = (dir_tmp_files.path / "tmp").string();
+        path_sa_file = prefix_tmp_files + ".sa";
+        baseline_mem_usage = current_memory_usage();
+        baseline_peak_mem_usage = peak_memory_usage();
     }
 
     /**
@@ -477,17 +634,30 @@ public:
     void log_mem_usage()
     {
         std::cout << "current memory allocation: "
-                  << format_size(malloc_count_current() - baseline_mem_usage)
+                  << format_size(std::max(current_memory_usage(), baseline_mem_usage) - baseline_mem_usage)
                   << std::endl;
     }
 
+    /**
+     * @brief returns the peak memory allocation since the start of the construction; the peak of the process is not
+     * reset, so if the construction has not exceeded the peak before its start, only its current memory allocation
+     * is known
+     * @return peak memory allocation since the start of the construction in bytes
+     */
+    uint64_t peak_mem_usage_since_start()
+    {
+        uint64_t peak = peak_memory_usage();
+        if (peak <= baseline_peak_mem_usage) peak = current_memory_usage();
+        return std::max(peak, baseline_mem_usage) - baseline_mem_usage;
+    }
+
     /**
      * @brief logs the peak memory usage until now
      */
     void log_peak_mem_usage()
     {
         std::cout << "peak memory allocation until now: "
-                  << format_size(std::max(malloc_count_peak() - baseline_mem_usage, bigbwt_peak_mem_usage))
+                  << format_size(peak_mem_usage_since_start())
                   << std::endl;
     }
 
@@ -497,7 +667,7 @@ public:
     void log_finished()
     {
         uint64_t time_construction = time_diff_ns(time_start, now());
-        uint64_t peak_mem_usage = std::max(malloc_count_peak() - baseline_mem_usage, bigbwt_peak_mem_usage);
+        uint64_t peak_mem_usage = peak_mem_usage_since_start();
 
         std::cout << std::endl;
         std::cout << "construction time: " << format_time(time_construction) << std::endl;
@@ -512,6 +682,42 @@ public:
         }
     }
 
+    /**
+     * @brief chooses the minimum number of occurrences to use the rlzdsa instead of M_Phi^{-1}; it is calibrated if
+     * calibrate_min_occ is set, else it is estimated from n and r'
+     */
+    void choose_min_occ_threshold()
+        requires(support == _locate_hybrid)
+    {
+        if (!calibrate_min_occ) {
+            idx.estimate_min_occ_threshold();
+
+            if (log) {
+                if (mf_idx != NULL) *mf_idx << " min_occ_rlzdsa=" << idx.min_occ_rlzdsa;
+                std::cout << "minimum number of occurrences to use the rlzdsa: " << idx.min_occ_rlzdsa << std::endl;
+            }
+
+            return;
+        }
+
+        if (log) {
+            time = now();
+            std::cout << "calibrating the minimum number of occurrences to use the rlzdsa" << std::flush;
+        }
+
+        idx.calibrate_min_occ_threshold(64, seed);
+
+        if (log) {
+            if (mf_idx != NULL) {
+                *mf_idx << " time_calibrate=" << time_diff_ns(time, now());
+                *mf_idx << " min_occ_rlzdsa=" << idx.min_occ_rlzdsa;
+            }
+
+            time = log_runtime(time);
+            std::cout << "minimum number of occurrences to use the rlzdsa: " << idx.min_occ_rlzdsa << std::endl;
+        }
+    }
+
     /**
      * @brief logs statistics of T
      */
@@ -526,6 +732,142 @@ public:
         std::cout << "n = " << n << ", sigma = " << std::to_string(idx.sigma) << ", r = " << r << ", n/r = " << n_r << std::endl;
     }
 
+    /**
+     * @brief a construction phase that can be scheduled by run_phases
+     */
+    struct phase {
+        std::string name; // name of the phase (used for the log message and for the measurement output)
+        std::function<void(uint16_t)> run; // runs the phase with the given number of threads
+        std::vector<uint8_t> deps = {}; // indices of the phases that have to be finished before the phase can start
+        uint16_t max_threads = 0; // maximum number of threads the phase can use (0: no limit); I/O-bound phases use 1
+    };
+
+    /**
+     * @brief runs the phases in the order given by their dependencies; phases whose dependencies are finished run
+     * concurrently, each with its own share of the p threads (the free threads are split evenly among the phases that
+     * become ready, phases with a limit on their number of threads first); the phases do not log while they run, instead
+     * their runtimes are logged once all of them have finished
+     * @param phases the phases; each phase may only depend on phases preceding it
+     */
+    void run_phases(const std::vector<phase>& phases)
+    {
+        if (p == 1 || phases.size() == 1) {
+            for (const phase& ph : phases) {
+                ph.run(ph.max_threads == 0 ? p : std::min(p, ph.max_threads));
+            }
+
+            return;
+        }
+
+        if (log) {
+            time = now();
+            std::cout << "running";
+
+            for (uint8_t i = 0; i < phases.size(); i++) {
+                std::cout << (i == 0 ? " " : (i == phases.size() - 1 ? " and " : ", ")) << phases[i].name;
+            }
+
+            std::cout << " concurrently" << std::flush;
+        }
+
+        bool _log = log;
+        log = false;
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::vector<uint8_t> state(phases.size(), 0); // 0: waiting, 1: running, 2: finished
+        std::vector<uint64_t> times(phases.size());
+        std::vector<std::thread> threads;
+        std::exception_ptr exception = nullptr;
+        uint16_t p_free = p;
+        uint8_t num_finished = 0;
+        uint8_t num_started = 0;
+
+        {
+            std::unique_lock lock(mtx);
+
+            while (num_finished < phases.size()) {
+                std::vector<uint8_t> ready;
+
+                if (exception == nullptr) {
+                    for (uint8_t i = 0; i < phases.size(); i++) {
+                        if (state[i] == 0 && std::all_of(phases[i].deps.begin(), phases[i].deps.end(), [&](uint8_t d) { return state[d] == 2; })) {
+                            ready.emplace_back(i);
+                        }
+                    }
+                }
+
+                if (!ready.empty() && p_free > 0) {
+                    // start the phases with a limit on their number of threads first, s.t. the others get the rest
+                    std::stable_sort(ready.begin(), ready.end(), [&](uint8_t i, uint8_t j) {
+                        return phases[i].max_threads != 0 && (phases[j].max_threads == 0 || phases[i].max_threads < phases[j].max_threads);
+                    });
+
+                    uint16_t num_ready = std::min<uint16_t>(ready.size(), p_free);
+
+                    for (uint16_t k = 0; k < num_ready; k++) {
+                        uint8_t i = ready[k];
+                        uint16_t p_i = p_free / (num_ready - k);
+                        if (phases[i].max_threads != 0) p_i = std::min(p_i, phases[i].max_threads);
+                        p_free -= p_i;
+                        state[i] = 1;
+                        num_started++;
+
+                        threads.emplace_back([&, i, p_i]() {
+                            std::exception_ptr e = nullptr;
+                            auto time_start_i = now();
+
+                            try {
+                                phases[i].run(p_i);
+                            } catch (...) {
+                                e = std::current_exception();
+                            }
+
+                            std::lock_guard lock_i(mtx);
+                            times[i] = time_diff_ns(time_start_i, now());
+                            if (e != nullptr && exception == nullptr) exception = e;
+                            state[i] = 2;
+                            p_free += p_i;
+                            num_finished++;
+                            cv.notify_one();
+                        });
+                    }
+                } else if (num_finished == num_started && (exception != nullptr || ready.empty())) {
+                    break;
+                } else {
+                    cv.wait(lock);
+                }
+            }
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        log = _log;
+
+        if (exception != nullptr) {
+            if (log) std::cout << std::endl;
+            std::rethrow_exception(exception);
+        }
+
+        if (log) {
+            if (mf_idx != NULL) {
+                for (uint8_t i = 0; i < phases.size(); i++) {
+                    *mf_idx << " time_" << phases[i].name << "=" << times[i];
+                }
+            }
+
+            time = log_runtime(time);
+
+            for (uint8_t i = 0; i < phases.size(); i++) {
+                std::cout << (i == 0 ? "" : ", ") << phases[i].name << " took ~ " << format_time(times[i]);
+            }
+
+            std::cout << std::endl;
+        }
+    }
+
     // ############################# CONSTRUCTORS #############################
 
     void read_parameters(move_r_params& params)
@@ -534,10 +876,21 @@ public:
         this->p = params.num_threads;
         this->mode = params.mode;
         idx.a = params.a;
+        idx.sr_scp = std::max<uint16_t>(1, params.sr_scp);
+        idx.max_scan_l_ = params.max_scan_l_;
         this->log = params.log;
         this->mf_idx = params.mf_idx;
         this->mf_mds = params.mf_mds;
         this->name_text_file = params.name_text_file;
+        this->seed = params.seed;
+        this->path_reference = params.path_reference;
+        this->embed_reference = params.embed_reference;
+        this->calibrate_min_occ = params.calibrate_min_occ;
+        this->max_memory = params.max_memory;
+        this->checkpoint_dir = params.checkpoint_dir;
+        this->resume = params.resume;
+        this->keep_checkpoint = params.keep_checkpoint;
+        this->tmp_dir = params.tmp_dir;
     }
 
     /**
@@ -560,27 +913,28 @@ public:
         read_parameters(params);
         prepare_phase_1();
 
+        min_valid_char = 1;
+        T.push_back(uchar_to_char((uint8_t)0));
+        n = T.size();
+        idx.n = n;
+        preprocess_t(true, false);
+        if (max_memory != 0) choose_construction_mode();
+        if (!checkpoint_dir.empty()) init_checkpoints();
+
         if (mode == _suffix_array || mode == _suffix_array_space) {
-            min_valid_char = 1;
-            T.push_back(uchar_to_char((uint8_t)0));
-            n = T.size();
-            idx.n = n;
-            preprocess_t(true, false);
             construct_from_sa();
-
-            if (!delete_T) {
-                T.resize(n - 1);
-                if (idx.symbols_remapped)
-                    unmap_t();
-            }
         } else {
-            min_valid_char = 3;
-            n = T.size() + 1;
-            idx.n = n;
-            preprocess_and_store_t_in_file();
-            construct_from_bigbwt();
+            construct_from_pfp();
         }
 
+        if (!delete_T) {
+            T.resize(n - 1);
+            if (idx.symbols_remapped)
+                unmap_t();
+        }
+
+        if constexpr (support == _locate_hybrid) choose_min_occ_threshold();
+        if (!checkpoint_dir.empty() && !keep_checkpoint) remove_checkpoints();
         if (log) log_finished();
     }
 
@@ -608,6 +962,8 @@ public:
         n = T.size();
         idx.n = n;
         preprocess_t(true, false);
+        if (max_memory != 0) choose_construction_mode();
+        if (!checkpoint_dir.empty()) init_checkpoints();
         construct_from_sa();
 
         if (!delete_T) {
@@ -616,6 +972,8 @@ public:
                 unmap_t();
         }
 
+        if constexpr (support == _locate_hybrid) choose_min_occ_threshold();
+        if (!checkpoint_dir.empty() && !keep_checkpoint) remove_checkpoints();
         if (log) log_finished();
     }
 
@@ -636,18 +994,57 @@ public:
     {
         read_parameters(params);
         prepare_phase_1();
+        min_valid_char = 1;
+        read_t_from_file(T_ifile);
+        preprocess_t(true, false);
+        if (max_memory != 0) choose_construction_mode();
+        if (!checkpoint_dir.empty()) init_checkpoints();
+
+        if (mode == _suffix_array || mode == _suffix_array_space) {
+            construct_from_sa();
+        } else {
+            delete_T = true;
+            construct_from_pfp();
+        }
+
+        if constexpr (support == _locate_hybrid) choose_min_occ_threshold();
+        if (!checkpoint_dir.empty() && !keep_checkpoint) remove_checkpoints();
+        if (log) log_finished();
+    }
+
+    /**
+     * @brief constructs a move_r index from an input file, which is memory-mapped instead of read into memory
+     * @param index The move-r index to construct
+     * @param path_t_file path to the file containing T
+     * @param params construction parameters
+     */
+    construction(move_r<support, sym_t, pos_t>& index, const std::filesystem::path& path_t_file, move_r_params params)
+        requires(str_input)
+        : T_str(T_str_tmp)
+        , T_vec(T_vec_tmp)
+        , idx(index)
+        , SA_32(SA_32_tmp)
+        , SA_64(SA_64_tmp)
+        , L(L_tmp)
+    {
+        read_parameters(params);
+        prepare_phase_1();
+        min_valid_char = 1;
+        // T is only needed during the construction, so it can be unmapped as soon as possible
+        delete_T = true;
+        mmap_t_file(path_t_file);
+        preprocess_t(true, false);
+        if (max_memory != 0) choose_construction_mode();
+        if (!checkpoint_dir.empty()) init_checkpoints();
 
         if (mode == _suffix_array || mode == _suffix_array_space) {
-            min_valid_char = 1;
-            read_t_from_file(T_ifile);
-            preprocess_t(true, false);
             construct_from_sa();
         } else {
-            min_valid_char = 3;
-            preprocess_t(false, true, &T_ifile);
-            construct_from_bigbwt();
+            construct_from_pfp();
         }
 
+        if constexpr (support == _locate_hybrid) choose_min_occ_threshold();
+        if (!checkpoint_dir.empty() && !keep_checkpoint) remove_checkpoints();
         if (log) log_finished();
     }
 
@@ -691,6 +1088,79 @@ public:
         construct_from_sa_and_l<int64_t>();
     }
 
+    /**
+     * @brief constructs a move_r index from the run-length encoded bwt of the input
+     * @param index The move-r index to construct
+     * @param run_heads the characters of the bwt runs
+     * @param run_lengths the lengths of the bwt runs
+     * @param params construction parameters
+     */
+    construction(move_r<support, sym_t, pos_t>& index, const std::string& run_heads, const std::vector<pos_t>& run_lengths, move_r_params params)
+        requires(str_input && !has_rlzdsa)
+        : T_str(T_str_tmp)
+        , T_vec(T_vec_tmp)
+        , L(L_tmp)
+        , SA_32(SA_32_tmp)
+        , SA_64(SA_64_tmp)
+        , idx(index)
+    {
+        read_parameters(params);
+        prepare_phase_1();
+        construct_from_rlbwt(run_heads, run_lengths);
+        if (log) log_finished();
+    }
+
+    /**
+     * @brief rebalances the move data structures of an index to a new balancing parameter
+     * @param index The move-r index to rebalance
+     * @param a new balancing parameter
+     * @param num_threads maximum number of threads to use
+     * @param log controls, whether to print log messages
+     */
+    construction(move_r<support, sym_t, pos_t>& index, uint16_t a, uint16_t num_threads, bool log)
+        : T_str(T_str_tmp)
+        , T_vec(T_vec_tmp)
+        , L(L_tmp)
+        , SA_32(SA_32_tmp)
+        , SA_64(SA_64_tmp)
+        , idx(index)
+    {
+        this->p = std::max<uint16_t>(1, num_threads);
+        this->log = log;
+        prepare_phase_1();
+        n = idx.n;
+        r = idx.r;
+        p = std::max<uint16_t>(1, std::min<pos_t>(p, r));
+        rebalance(a);
+        if (log) log_finished();
+    }
+
+    /**
+     * @brief builds the locate support of an index, whose M_LF (with L') and RS_L' have been taken from a count-only index
+     * @param index The move-r index to build the locate support of
+     * @param num_threads maximum number of threads to use
+     * @param log controls, whether to print log messages
+     */
+    construction(move_r<support, sym_t, pos_t>& index, uint16_t num_threads, bool log)
+        requires(supports_locate && !has_rlzdsa)
+        : T_str(T_str_tmp)
+        , T_vec(T_vec_tmp)
+        , L(L_tmp)
+        , SA_32(SA_32_tmp)
+        , SA_64(SA_64_tmp)
+        , idx(index)
+    {
+        this->p = std::max<uint16_t>(1, num_threads);
+        this->log = log;
+        prepare_phase_1();
+        n = idx.n;
+        r = idx.r;
+        r_ = idx.r_;
+        p = std::max<uint16_t>(1, std::min<pos_t>(p, r));
+        build_locate_lf();
+        if (log) log_finished();
+    }
+
     // ############################# CONSTRUCTION #############################
 
     /**
@@ -709,7 +1179,7 @@ public:
         build_rlbwt_c<_bwt, sa_sint_t>();
         if (log) log_statistics();
         build_ilf();
-        build_mlf();
+        build_mlf(p);
 
         if constexpr (supports_locate) {
             build_iphim1_sa<false, sa_sint_t>();
@@ -720,16 +1190,27 @@ public:
 
         if constexpr (supports_multiple_locate) {
             if constexpr (support == _locate_move) {
-                sort_iphim1();
-                build_mphim1();
+                run_phases({
+                    { .name = "build_rsl_", .run = [&](uint16_t p_rsl) { build_rsl_(p_rsl); } },
+                    { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } },
+                    { .name = "build_mphi", .run = [&](uint16_t p_mphi) { build_mphim1(p_mphi); }, .deps = { 1 } }
+                });
+                if (log && mf_idx != NULL) *mf_idx << " r__=" << r__;
                 build_saphim1();
                 build_de();
             } else if constexpr (support == _locate_rlzdsa) {
                 construct_rlzdsa<false, sa_sint_t>();
+            } else if constexpr (support == _locate_hybrid) {
+                sort_iphim1(p);
+                construct_rlzdsa<false, sa_sint_t>();
+                build_mphim1(p);
+                build_saphim1();
+                build_de();
             }
         }
 
-        build_rsl_();
+        if constexpr (support != _locate_move) build_rsl_(p);
+        if constexpr (support == _locate_hybrid) choose_min_occ_threshold();
         if (log) log_finished();
     }
 
@@ -757,12 +1238,19 @@ public:
         bool _space = mode == _suffix_array_space;
 
         prepare_phase_2();
-        build_sa<sa_sint_t>();
+
+        if (resume_phase("sa")) {
+            load_sa_checkpoint<sa_sint_t>();
+        } else {
+            build_sa<sa_sint_t>();
+            if (!checkpoint_dir.empty()) store_sa_checkpoint<sa_sint_t>();
+        }
+
         build_rlbwt_c<_sa, sa_sint_t>();
         if (log) log_statistics();
         build_ilf();
         if (_space) store_rlbwt();
-        build_mlf();
+        build_mlf(p);
         if (_space) load_rlbwt();
 
         if constexpr (supports_locate) {
@@ -771,36 +1259,81 @@ public:
 
             if constexpr (supports_multiple_locate) {
                 if constexpr (support == _locate_move) {
-                    if (_space) store_sas();
-                    build_rsl_();
-                    if (_space) store_rsl_();
-                    if (_space) store_mlf();
-                    sort_iphim1();
-                    build_mphim1();
-                    if (_space) load_sas();
+                    if (_space) {
+                        store_sas();
+                        build_rsl_(p);
+                        run_phases({
+                            { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                            { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                        });
+                        build_mphim1(p);
+                        load_sas();
+                    } else {
+                        run_phases({
+                            { .name = "build_rsl_", .run = [&](uint16_t p_rsl) { build_rsl_(p_rsl); } },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } },
+                            { .name = "build_mphi", .run = [&](uint16_t p_mphi) { build_mphim1(p_mphi); }, .deps = { 1 } }
+                        });
+                        if (log && mf_idx != NULL) *mf_idx << " r__=" << r__;
+                    }
+
                     build_saphim1();
                     build_de();
                     if (_space) load_mlf();
                     if (_space) load_rsl_();
                 } else if constexpr (support == _locate_rlzdsa) {
-                    if (_space) store_sas_idx();
-                    build_rsl_();
-                    if (_space) store_rsl_();
-                    if (_space) store_mlf();
-                    sort_iphim1();
+                    if (_space) {
+                        store_sas_idx();
+                        build_rsl_(p);
+                        run_phases({
+                            { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                            { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                        });
+                    } else {
+                        run_phases({
+                            { .name = "build_rsl_", .run = [&](uint16_t p_rsl) { build_rsl_(p_rsl); } },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                        });
+                    }
+
                     construct_rlzdsa<false, sa_sint_t>();
                     if (_space) load_sas_idx();
                     if (_space) load_mlf();
                     if (_space) load_rsl_();
+                } else if constexpr (support == _locate_hybrid) {
+                    if (_space) {
+                        store_sas();
+                        build_rsl_(p);
+                        run_phases({
+                            { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                            { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                        });
+                    } else {
+                        run_phases({
+                            { .name = "build_rsl_", .run = [&](uint16_t p_rsl) { build_rsl_(p_rsl); } },
+                            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                        });
+                    }
+
+                    construct_rlzdsa<false, sa_sint_t>();
+                    build_mphim1(p);
+                    if (_space) load_sas();
+                    build_saphim1();
+                    build_de();
+                    if (_space) load_mlf();
+                    if (_space) load_rsl_();
                 }
             } else {
                 if (_space) store_sas_idx();
-                build_rsl_();
+                build_rsl_(p);
                 if (_space) load_sas_idx();
             }
         } else {
             build_l__sas<false>();
-            build_rsl_();
+            build_rsl_(p);
         }
 
         if constexpr (int_alphabet) {
@@ -810,30 +1343,38 @@ public:
     }
 
     /**
-     * @brief constructs the index from a file using Big-BWT
+     * @brief constructs the index using prefix-free parsing
      */
-    void construct_from_bigbwt()
+    void construct_from_pfp()
     {
         prepare_phase_2();
-        bigbwt();
-        build_rlbwt_c<_bwt_file, int32_t>();
+
+        if (resume_phase("bwt")) {
+            load_bwt_checkpoint();
+        } else {
+            pfp();
+            if (!checkpoint_dir.empty()) store_bwt_checkpoint();
+        }
+
+        build_rlbwt_c<_bwt, int32_t>();
         if (log) log_statistics();
         build_ilf();
         store_rlbwt();
-        build_mlf();
+        build_mlf(p);
         load_rlbwt();
 
         if constexpr (supports_locate) {
             if constexpr (supports_multiple_locate) {
                 if constexpr (support == _locate_move) {
-                    read_iphim1_bigbwt();
                     build_l__sas<true>();
                     store_sas();
-                    build_rsl_();
-                    store_mlf();
-                    store_rsl_();
-                    sort_iphim1();
-                    build_mphim1();
+                    build_rsl_(p);
+                    run_phases({
+                        { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                        { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                        { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                    });
+                    build_mphim1(p);
                     load_sas();
                     build_saphim1();
                     build_de();
@@ -843,71 +1384,151 @@ public:
                     build_iphim1_sa<true, int32_t>();
                     build_l__sas<true>();
                     store_sas_idx();
-                    build_rsl_();
-                    store_rsl_();
-                    store_mlf();
-                    sort_iphim1();
+                    build_rsl_(p);
+                    run_phases({
+                        { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                        { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                        { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                    });
                     construct_rlzdsa<true, int32_t>();
                     load_mlf();
                     load_rsl_();
                     load_sas_idx();
+                } else if constexpr (support == _locate_hybrid) {
+                    build_iphim1_sa<true, int32_t>();
+                    build_l__sas<true>();
+                    store_sas();
+                    build_rsl_(p);
+                    run_phases({
+                        { .name = "store_rsl_", .run = [&](uint16_t) { store_rsl_(); }, .max_threads = 1 },
+                        { .name = "store_mlf", .run = [&](uint16_t) { store_mlf(); }, .max_threads = 1 },
+                        { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } }
+                    });
+                    construct_rlzdsa<true, int32_t>();
+                    build_mphim1(p);
+                    load_sas();
+                    build_saphim1();
+                    build_de();
+                    load_mlf();
+                    load_rsl_();
                 }
             } else {
-                read_iphim1_bigbwt();
                 build_l__sas<true>();
                 store_sas_idx();
-                build_rsl_();
+                build_rsl_(p);
                 load_sas_idx();
             }
         } else {
             build_l__sas<false>();
-            build_rsl_();
+            build_rsl_(p);
         }
     };
 
+    /**
+     * @brief constructs the index from the run-length encoded bwt without building the suffix array
+     * @param run_heads the characters of the bwt runs
+     * @param run_lengths the lengths of the bwt runs
+     */
+    void construct_from_rlbwt(const std::string& run_heads, const std::vector<pos_t>& run_lengths)
+    {
+        read_rlbwt(run_heads, run_lengths);
+        if (log) log_statistics();
+        build_ilf();
+        build_mlf(p);
+        build_l__sas<false>();
+        build_rsl_(p);
+        if constexpr (supports_locate) build_locate_lf();
+    }
+
+    /**
+     * @brief builds the data structures for locate (SA_s, or M_Phi^{-1}, SA_Phi^{-1} and D_e) from M_LF and L' by
+     * traversing M_LF
+     */
+    void build_locate_lf()
+        requires(supports_locate && !has_rlzdsa)
+    {
+        build_iphim1_sas_lf();
+
+        if constexpr (supports_multiple_locate) {
+            sort_iphim1(p);
+            build_mphim1(p);
+            build_saphim1();
+            build_de();
+        }
+    }
+
     /**
      * @brief builds the rlzdsa
-     * @tparam bigbwt true <=> read suffix array values from the file output by bigbwt
+     * @tparam sa_file true <=> read suffix array values from the suffix array file written during prefix-free parsing
      * @tparam sa_sint_t signed integer type to use for the suffix array entries
      */
-    template <bool bigbwt, typename sa_sint_t>
+    template <bool sa_file, typename sa_sint_t>
     void construct_rlzdsa()
     {
+        n_R = n;
+        idx.n_R = n;
+
+        if (!path_reference.empty()) {
+            // the value and position types of the index of rev(R) are determined by the reference
+            std::ifstream ref_file(path_reference);
+            bool sad_64, irr_pos_64;
+            std::tie(std::ignore, sad_64, irr_pos_64) = read_reference_header(ref_file, path_reference);
+            ref_file.close();
+
+            if (!sad_64) {
+                construct_rlzdsa<sa_file, uint32_t, uint32_t, sa_sint_t>();
+            } else if (!irr_pos_64) {
+                construct_rlzdsa<sa_file, uint64_t, uint32_t, sa_sint_t>();
+            } else {
+                construct_rlzdsa<sa_file, uint64_t, uint64_t, sa_sint_t>();
+            }
+
+            return;
+        }
+
         size_R_target = std::min<pos_t>(std::max<pos_t>(1, n / 3), 5.2 * r);
         seg_size = std::min<pos_t>(3072, size_R_target);
 
         if constexpr (std::is_same_v<pos_t, uint32_t>) {
-            construct_rlzdsa<bigbwt, uint32_t, uint32_t, sa_sint_t>();
+            construct_rlzdsa<sa_file, uint32_t, uint32_t, sa_sint_t>();
         } else if (2 * n <= UINT_MAX) {
-            construct_rlzdsa<bigbwt, uint32_t, uint32_t, sa_sint_t>();
+            construct_rlzdsa<sa_file, uint32_t, uint32_t, sa_sint_t>();
         } else if (size_R_target + seg_size <= UINT_MAX) {
-            construct_rlzdsa<bigbwt, uint64_t, uint32_t, sa_sint_t>();
+            construct_rlzdsa<sa_file, uint64_t, uint32_t, sa_sint_t>();
         } else {
-            construct_rlzdsa<bigbwt, uint64_t, uint64_t, sa_sint_t>();
+            construct_rlzdsa<sa_file, uint64_t, uint64_t, sa_sint_t>();
         }
     }
 
     /**
      * @brief builds the rlzdsa
-     * @tparam bigbwt true <=> read suffix array values from the file output by bigbwt
+     * @tparam sa_file true <=> read suffix array values from the suffix array file written during prefix-free parsing
      * @tparam sad_t type of the values in SA^d
      * @tparam irr_pos_t position type (pos_t) for the index of rev(R)
      * @tparam sa_sint_t signed integer type to use for the suffix array entries
      */
-    template <bool bigbwt, typename sad_t, typename irr_pos_t, typename sa_sint_t>
+    template <bool sa_file, typename sad_t, typename irr_pos_t, typename sa_sint_t>
     void construct_rlzdsa()
     {
-        bool _space = bigbwt || mode == _suffix_array_space;
-        build_freq_sad<bigbwt, sad_t, sa_sint_t>();
-        build_r<bigbwt, sad_t, sa_sint_t>();
-        if (_space) store_r();
-        build_idx_rev_r<sad_t, irr_pos_t>();
+        bool _space = sa_file || mode == _suffix_array_space;
+
+        if (path_reference.empty() && resume_phase("reference")) {
+            load_reference_checkpoint<sad_t, irr_pos_t>();
+        } else if (path_reference.empty()) {
+            build_freq_sad<sa_file, sad_t, sa_sint_t>();
+            build_r<sa_file, sad_t, sa_sint_t>();
+            if (_space) store_r();
+            build_idx_rev_r<sad_t, irr_pos_t>();
+            if (_space) load_r();
+            if (!checkpoint_dir.empty()) store_reference_checkpoint<sad_t, irr_pos_t>();
+        } else {
+            load_reference<sad_t, irr_pos_t>();
+        }
 
         if (_space) {
-            load_r();
-            build_rlzdsa_factorization<bigbwt, true, sad_t, irr_pos_t, sa_sint_t>();
+            build_rlzdsa_factorization<sa_file, true, sad_t, irr_pos_t, sa_sint_t>();
         } else {
-            build_rlzdsa_factorization<bigbwt, false, sad_t, irr_pos_t, sa_sint_t>();
+            build_rlzdsa_factorization<sa_file, false, sad_t, irr_pos_t, sa_sint_t>();
         }
     }
 
@@ -929,6 +1550,12 @@ public:
     template <rlbwt_build_mode mode, typename sa_sint_t>
     void build_rlbwt_c();
 
+    /**
+     * @brief merges the last run in each thread's section of the RLBWT with the first run in the next thread's section,
+     * if their characters are equal, and computes r_p and r
+     */
+    void merge_rlbwt_sections();
+
     /**
      * @brief processes the C-array
      */
@@ -941,15 +1568,16 @@ public:
 
     /**
      * @brief builds M_LF
+     * @param p_mlf number of threads to use
      */
-    void build_mlf();
+    void build_mlf(uint16_t p_mlf);
 
     /**
      * @brief builds I_Phi^{m1} from SA in memory
-     * @tparam bigbwt true <=> read I_Phi from the SA file output by Big-BWT
+     * @tparam sa_file true <=> read I_Phi^{-1} from the suffix array file written during prefix-free parsing
      * @tparam sa_sint_t suffix array signed integer type
      */
-    template <bool bigbwt, typename sa_sint_t>
+    template <bool sa_file, typename sa_sint_t>
     void build_iphim1_sa();
 
     /**
@@ -961,13 +1589,15 @@ public:
 
     /**
      * @brief sorts I_Phi^{-1}
+     * @param p_sort number of threads to use
      */
-    void sort_iphim1();
+    void sort_iphim1(uint16_t p_sort);
 
     /**
      * @brief builds M_Phi^{-1}
+     * @param p_mphi number of threads to use
      */
-    void build_mphim1();
+    void build_mphim1(uint16_t p_mphi);
 
     /**
      * @brief builds SA_Phi^{-1}
@@ -981,8 +1611,9 @@ public:
 
     /**
      * @brief builds RS_L'
+     * @param p_rsl number of threads to use
      */
-    void build_rsl_();
+    void build_rsl_(uint16_t p_rsl);
 
     /**
      * @brief stores the RLBWT to disk
@@ -1042,6 +1673,30 @@ public:
      */
     void read_t_from_file(std::ifstream& t_file);
 
+    /**
+     * @brief memory-maps the file containing T (read-only until T has to be remapped, then copy-on-write); throws
+     * std::runtime_error if the file cannot be opened or mapped
+     * @param path_t_file path to the file containing T
+     */
+    void mmap_t_file(const std::filesystem::path& path_t_file);
+
+    /**
+     * @brief unmaps the file containing T, if it is mapped
+     */
+    void unmap_t_file();
+
+    /**
+     * @brief estimates r by building the BWT of a prefix of T and extrapolating its number of runs
+     * @return estimate of r
+     */
+    pos_t estimate_r();
+
+    /**
+     * @brief chooses the construction mode and the number of threads, s.t. the estimated peak memory usage of the
+     * construction does not exceed max_memory
+     */
+    void choose_construction_mode();
+
     /**
      * @brief builds the suffix array
      * @tparam sa_sint_t suffix array signed integer type
@@ -1049,6 +1704,11 @@ public:
     template <typename sa_sint_t>
     void build_sa();
 
+    /**
+     * @brief maps T to its effective alphabet (only for integer alphabets)
+     */
+    void map_t();
+
     /**
      * @brief unmaps T from the internal alphabet
      */
@@ -1064,41 +1724,177 @@ public:
      */
     void load_mapintext();
 
-    // ############################# Big-BWT CONSTRUCTION METHODS #############################
+    // ############################# PREFIX-FREE PARSING CONSTRUCTION METHODS #############################
+
+    /**
+     * @brief computes the BWT of T using prefix-free parsing; additionally computes I_Phi^{-1} (if supports_locate
+     * and !has_rlzdsa) or writes the suffix array to a file (if has_rlzdsa)
+     */
+    void pfp();
+
+    /**
+     * @brief computes the prefix-free parse of T and the sorted dictionary
+     */
+    void parse_t();
+
+    /**
+     * @brief computes the suffix array of an integer string
+     * @tparam int_t signed integer type
+     * @param T_int the integer string
+     * @param SA_int vector to store the suffix array in
+     * @param sigma alphabet size of T_int
+     */
+    template <typename int_t>
+    void suffix_array_int(std::vector<int_t>& T_int, std::vector<int_t>& SA_int, int_t sigma);
+
+    /**
+     * @brief sorts the rotations of the parse and builds the inverted lists of the BWT of the parse
+     * @tparam int_t signed integer type to use for the suffix array of the parse
+     */
+    template <typename int_t>
+    void sort_parse();
+
+    /**
+     * @brief sorts the suffixes of length > w of the phrases in the dictionary and groups equal suffixes
+     * @tparam int_t signed integer type to use for the suffix array of the dictionary
+     */
+    template <typename int_t>
+    void sort_dictionary_suffixes();
+
+    /**
+     * @brief builds the BWT (and I_Phi^{-1} or the suffix array file) from the sorted dictionary and parse
+     */
+    void build_bwt_pfp();
+
+    // ############################# RLBWT CONSTRUCTION METHODS #############################
 
     /**
-     * @brief preprocesses T and stores it in a file
+     * @brief reads the RLBWT from the runs given by run_heads and run_lengths (merging adjacent runs with equal
+     * characters) and builds C
+     * @param run_heads the characters of the bwt runs
+     * @param run_lengths the lengths of the bwt runs
      */
-    void preprocess_and_store_t_in_file();
+    void read_rlbwt(const std::string& run_heads, const std::vector<pos_t>& run_lengths);
 
     /**
-     * @brief computes the BWT (and suffix array samples) using Big-BWT
+     * @brief builds I_Phi^{-1} (ordered by the BWT runs) and SA_s by a parallel traversal of the LF-cycle with M_LF;
+     * requires M_LF and L' to be built
      */
-    void bigbwt();
+    void build_iphim1_sas_lf();
+
+    // ############################# CHECKPOINT METHODS #############################
 
     /**
-     * @brief reads I_Phi^{-1}
+     * @brief returns the path of a file in the checkpoint directory
+     * @param file_name name of the file
+     * @return path of the file
      */
-    void read_iphim1_bigbwt();
+    inline std::string checkpoint_file(const std::string& file_name)
+    {
+        return checkpoint_dir + "/" + file_name;
+    }
+
+    /**
+     * @brief creates the checkpoint directory and, if resume is set, reads and validates the manifest of the checkpoint
+     */
+    void init_checkpoints();
+
+    /**
+     * @brief checks whether a phase can be skipped, because it has been completed in the checkpoint and its files are complete
+     * @param phase name of the phase
+     * @return whether the phase can be skipped
+     */
+    bool resume_phase(const std::string& phase);
+
+    /**
+     * @brief marks a phase as completed by adding its files to the manifest of the checkpoint
+     * @param phase name of the phase
+     * @param file_names names of the files (in the checkpoint directory) storing the outputs of the phase
+     */
+    void checkpoint_phase(const std::string& phase, const std::vector<std::string>& file_names);
+
+    /**
+     * @brief removes the checkpoint after the construction has finished
+     */
+    void remove_checkpoints();
+
+    /**
+     * @brief writes the suffix array to the checkpoint
+     * @tparam sa_sint_t suffix array signed integer type
+     */
+    template <typename sa_sint_t>
+    void store_sa_checkpoint();
+
+    /**
+     * @brief reads the suffix array from the checkpoint
+     * @tparam sa_sint_t suffix array signed integer type
+     */
+    template <typename sa_sint_t>
+    void load_sa_checkpoint();
+
+    /**
+     * @brief writes the BWT (and I_Phi^{-1} or the suffix array file) computed by prefix-free parsing to the checkpoint
+     */
+    void store_bwt_checkpoint();
+
+    /**
+     * @brief reads the BWT (and I_Phi^{-1}) computed by prefix-free parsing from the checkpoint
+     */
+    void load_bwt_checkpoint();
+
+    /**
+     * @brief writes R and the move-r index of rev(R) to the checkpoint
+     * @tparam sad_t type of the values in SA^d
+     * @tparam irr_pos_t position type (pos_t) for the index of rev(R)
+     */
+    template <typename sad_t, typename irr_pos_t>
+    void store_reference_checkpoint();
+
+    /**
+     * @brief reads R and the move-r index of rev(R) from the checkpoint
+     * @tparam sad_t type of the values in SA^d
+     * @tparam irr_pos_t position type (pos_t) for the index of rev(R)
+     */
+    template <typename sad_t, typename irr_pos_t>
+    void load_reference_checkpoint();
+
+    // ############################# REBALANCING METHODS #############################
+
+    /**
+     * @brief rebalances M_LF (and M_Phi^{-1}) to the balancing parameter a and rebuilds the data structures that depend
+     * on the input intervals of M_LF (L', RS_L', SA_s, SA_Phi^{-1} and D_e)
+     * @param a new balancing parameter
+     */
+    void rebalance(uint16_t a);
+
+    /**
+     * @brief extracts I_LF (and I_Phi^{-1}) and the BWT runs from the balanced move data structures of the index
+     */
+    void extract_intervals();
+
+    /**
+     * @brief builds L' in M_LF (and SA_s) from the BWT runs extracted by extract_intervals()
+     */
+    void rebuild_l__sas();
 
     // ############################# rlzdsa CONSTRUCTION METHODS #############################
 
     /**
      * @brief builds freq_SAd
-     * @tparam bigbwt true <=> read suffix array values from the file output by bigbwt
+     * @tparam sa_file true <=> read suffix array values from the suffix array file written during prefix-free parsing
      * @tparam sad_t type of the values in SA^d
      * @tparam sa_sint_t signed integer type to use for the suffix array entries
      */
-    template <bool bigbwt, typename sad_t, typename sa_sint_t>
+    template <bool sa_file, typename sad_t, typename sa_sint_t>
     void build_freq_sad();
 
     /**
      * @brief builds R and rev(R)
-     * @tparam bigbwt true <=> read suffix array values from the file output by bigbwt
+     * @tparam sa_file true <=> read suffix array values from the suffix array file written during prefix-free parsing
      * @tparam sad_t type of the values in SA^d
      * @tparam sa_sint_t signed integer type to use for the suffix array entries
      */
-    template <bool bigbwt, typename sad_t, typename sa_sint_t>
+    template <bool sa_file, typename sad_t, typename sa_sint_t>
     void build_r();
 
     /**
@@ -1111,13 +1907,13 @@ public:
 
     /**
      * @brief builds the rlzdsa factorization
-     * @tparam bigbwt true <=> read suffix array values from the file output by bigbwt
+     * @tparam sa_file true <=> read suffix array values from the suffix array file written during prefix-free parsing
      * @tparam space true <=> store rlzdsa data structures in files during the construction
      * @tparam sad_t type of the values in SA^d
      * @tparam irr_pos_t position type (pos_t) for the index of rev(R)
      * @tparam sa_sint_t signed integer type to use for the suffix array entries
      */
-    template <bool bigbwt, bool space, typename sad_t, typename irr_pos_t, typename sa_sint_t>
+    template <bool sa_file, bool space, typename sad_t, typename irr_pos_t, typename sa_sint_t>
     void build_rlzdsa_factorization();
 
     /**
@@ -1129,9 +1925,22 @@ public:
      * @brief loads R from disk
      */
     void load_r();
+
+    /**
+     * @brief loads R and the move-r index of rev(R) from the reference file path_reference
+     * @tparam sad_t type of the values in SA^d
+     * @tparam irr_pos_t position type (pos_t) for the index of rev(R)
+     */
+    template <typename sad_t, typename irr_pos_t>
+    void load_reference();
 };
 
-#include "modes/bigbwt.cpp"
+#include "modes/checkpoint.cpp"
 #include "modes/common.cpp"
+#include "modes/m_lf_k.cpp"
+#include "modes/m_fl.cpp"
+#include "modes/pfp.cpp"
+#include "modes/rebalance.cpp"
+#include "modes/rlbwt.cpp"
 #include "modes/rlzdsa.cpp"
 #include "modes/sa.cpp"
\ No newline at end of file
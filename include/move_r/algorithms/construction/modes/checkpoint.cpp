@@ -0,0 +1,300 @@
+#pragma once
+
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::init_checkpoints()
+{
+    std::filesystem::create_directories(checkpoint_dir);
+    path_sa_file = checkpoint_file("sa_pfp");
+
+    // fingerprint of n and of T, s.t. checkpoints of other inputs are not resumed; T is split into blocks of a fixed
+    // size (independent of p) that are hashed in parallel, and then the hashes of the blocks are combined
+    uint64_t block_size = 1 << 20;
+    uint64_t num_blocks = (n + block_size - 1) / block_size;
+    std::vector<uint64_t> block_hashes(num_blocks);
+
+    #pragma omp parallel for num_threads(p) schedule(dynamic)
+    for (uint64_t b = 0; b < num_blocks; b++) {
+        uint64_t hash = 14695981039346656037ULL;
+        uint64_t e = std::min<uint64_t>(n, (b + 1) * block_size);
+
+        for (uint64_t i = b * block_size; i < e; i++) {
+            hash = (hash ^ (uint64_t)T<i_sym_t>(i)) * 1099511628211ULL;
+        }
+
+        block_hashes[b] = hash;
+    }
+
+    fingerprint_t = 14695981039346656037ULL ^ n;
+
+    for (uint64_t b = 0; b < num_blocks; b++) {
+        fingerprint_t = (fingerprint_t ^ block_hashes[b]) * 1099511628211ULL;
+    }
+
+    if (!resume) {
+        std::filesystem::remove(checkpoint_file("manifest"));
+        return;
+    }
+
+    std::ifstream manifest(checkpoint_file("manifest"));
+
+    if (!manifest.good()) {
+        if (log) std::cout << "no checkpoint found in " << checkpoint_dir << ", starting from scratch" << std::endl;
+        return;
+    }
+
+    std::string key;
+    std::string header;
+    uint64_t _support, _pos_t_size, _sym_t_size, _n, _fingerprint_t;
+    manifest >> header >> key >> _support >> key >> _pos_t_size >> key >> _sym_t_size >> key >> _n >> key >> _fingerprint_t;
+
+    // the checkpoint files store packed positions (see packed_t), so checkpoints with unpacked positions are not resumed
+    if (header != "move-r-checkpoint" || _support != support || _pos_t_size != sizeof(pck_t) ||
+        _sym_t_size != sizeof(sym_t) || _n != n || _fingerprint_t != fingerprint_t) {
+        if (log) std::cout << "warning: the checkpoint in " << checkpoint_dir << " does not match the input, ignoring it" << std::endl;
+        return;
+    }
+
+    std::string phase, file_name;
+    uint64_t file_size;
+
+    while (manifest >> key >> phase >> file_name >> file_size) {
+        checkpoint_files.emplace_back(phase, file_name, file_size);
+    }
+
+    if (log) {
+        std::cout << "found checkpoint in " << checkpoint_dir << " with the phases:";
+
+        for (uint64_t i = 0; i < checkpoint_files.size(); i++) {
+            if (i == 0 || std::get<0>(checkpoint_files[i - 1]) != std::get<0>(checkpoint_files[i])) {
+                std::cout << " " << std::get<0>(checkpoint_files[i]);
+            }
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+bool move_r<support, sym_t, pos_t>::construction<pck_t>::resume_phase(const std::string& phase)
+{
+    bool found = false;
+
+    for (auto& [cp_phase, file_name, file_size] : checkpoint_files) {
+        if (cp_phase == phase) {
+            std::string path = checkpoint_file(file_name);
+
+            // the phase can only be skipped if all of its files are complete
+            if (!std::filesystem::exists(path) || std::filesystem::file_size(path) != file_size) {
+                if (log) std::cout << "warning: the checkpoint file " << path << " is missing or incomplete, redoing the phase " << phase << std::endl;
+                return false;
+            }
+
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::checkpoint_phase(const std::string& phase, const std::vector<std::string>& file_names)
+{
+    std::erase_if(checkpoint_files, [&](auto& entry) { return std::get<0>(entry) == phase; });
+
+    for (const std::string& file_name : file_names) {
+        checkpoint_files.emplace_back(phase, file_name, std::filesystem::file_size(checkpoint_file(file_name)));
+    }
+
+    // write the manifest to a temporary file first, s.t. a crash while writing it cannot corrupt the checkpoint
+    std::ofstream manifest(checkpoint_file("manifest.tmp"));
+    manifest << "move-r-checkpoint" << std::endl;
+    manifest << "support " << (uint64_t)support << std::endl;
+    manifest << "pos_t_size " << sizeof(pck_t) << std::endl;
+    manifest << "sym_t_size " << sizeof(sym_t) << std::endl;
+    manifest << "n " << (uint64_t)n << std::endl;
+    manifest << "fingerprint " << fingerprint_t << std::endl;
+
+    for (auto& [cp_phase, file_name, file_size] : checkpoint_files) {
+        manifest << "phase " << cp_phase << " " << file_name << " " << file_size << std::endl;
+    }
+
+    manifest.close();
+    std::filesystem::rename(checkpoint_file("manifest.tmp"), checkpoint_file("manifest"));
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::remove_checkpoints()
+{
+    for (auto& [cp_phase, file_name, file_size] : checkpoint_files) {
+        std::filesystem::remove(checkpoint_file(file_name));
+    }
+
+    checkpoint_files.clear();
+    std::filesystem::remove(checkpoint_file("manifest"));
+    std::filesystem::remove(path_sa_file);
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_sa_checkpoint()
+{
+    if (log) {
+        time = now();
+        std::cout << "writing SA to the checkpoint" << std::flush;
+    }
+
+    std::vector<sa_sint_t>& SA = get_sa<sa_sint_t>();
+    std::ofstream file_sa(checkpoint_file("sa"));
+    write_to_file(file_sa, (char*)&SA[0], n * sizeof(sa_sint_t));
+    file_sa.close();
+    checkpoint_phase("sa", { "sa" });
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_store_checkpoint_sa=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_sa_checkpoint()
+{
+    // the suffix array has been computed for T in its effective alphabet
+    if constexpr (int_alphabet) map_t();
+
+    if (log) {
+        time = now();
+        std::cout << "reading SA from the checkpoint" << std::flush;
+    }
+
+    std::vector<sa_sint_t>& SA = get_sa<sa_sint_t>();
+    no_init_resize(SA, n);
+    std::ifstream file_sa(checkpoint_file("sa"));
+    read_from_file(file_sa, (char*)&SA[0], n * sizeof(sa_sint_t));
+    file_sa.close();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_load_checkpoint_sa=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_bwt_checkpoint()
+{
+    if (log) {
+        time = now();
+        std::cout << "writing the BWT to the checkpoint" << std::flush;
+    }
+
+    std::vector<std::string> file_names = { "bwt" };
+    std::ofstream file_bwt(checkpoint_file("bwt"));
+    write_to_file(file_bwt, L.c_str(), n);
+    file_bwt.close();
+
+    if constexpr (supports_locate && !has_rlzdsa) {
+        std::ofstream file_iphim1(checkpoint_file("iphim1"));
+        write_to_file(file_iphim1, (char*)&I_Phi_m1[0], I_Phi_m1.size() * sizeof(std::pair<pck_t, pck_t>));
+        file_iphim1.close();
+        file_names.emplace_back("iphim1");
+    }
+
+    // the suffix array file has been written to the checkpoint directory during prefix-free parsing
+    if constexpr (has_rlzdsa) {
+        file_names.emplace_back("sa_pfp");
+    }
+
+    checkpoint_phase("bwt", file_names);
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_store_checkpoint_bwt=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_bwt_checkpoint()
+{
+    if (log) {
+        time = now();
+        std::cout << "reading the BWT from the checkpoint" << std::flush;
+    }
+
+    no_init_resize(L, n);
+    std::ifstream file_bwt(checkpoint_file("bwt"));
+    read_from_file(file_bwt, L.c_str(), n);
+    file_bwt.close();
+
+    if constexpr (supports_locate && !has_rlzdsa) {
+        no_init_resize(I_Phi_m1, std::filesystem::file_size(checkpoint_file("iphim1")) / sizeof(std::pair<pck_t, pck_t>));
+        std::ifstream file_iphim1(checkpoint_file("iphim1"));
+        read_from_file(file_iphim1, (char*)&I_Phi_m1[0], I_Phi_m1.size() * sizeof(std::pair<pck_t, pck_t>));
+        file_iphim1.close();
+    }
+
+    if (delete_T) {
+        T_str.clear();
+        T_str.shrink_to_fit();
+        unmap_t_file();
+    }
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_load_checkpoint_bwt=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename sad_t, typename irr_pos_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_reference_checkpoint()
+{
+    if (log) {
+        time = now();
+        std::cout << "writing R and the move-r index of rev(R) to the checkpoint" << std::flush;
+    }
+
+    // the checkpoint has the format of a reference file written by move_r::export_reference()
+    std::ofstream file_ref(checkpoint_file("reference"));
+    bool sad_64 = std::is_same_v<sad_t, uint64_t>;
+    bool irr_pos_64 = std::is_same_v<irr_pos_t, uint64_t>;
+    write_reference_header(file_ref, n_R, sad_64, irr_pos_64);
+    idx._R.serialize(file_ref);
+    get_idx_revR<sad_t, irr_pos_t>().serialize(file_ref);
+    file_ref.close();
+    checkpoint_phase("reference", { "reference" });
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_store_checkpoint_reference=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename sad_t, typename irr_pos_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_reference_checkpoint()
+{
+    // the reference is embedded into the index, as if it had been built
+    bool _embed_reference = embed_reference;
+    path_reference = checkpoint_file("reference");
+    embed_reference = true;
+    load_reference<sad_t, irr_pos_t>();
+    path_reference = "";
+    embed_reference = _embed_reference;
+}
\ No newline at end of file
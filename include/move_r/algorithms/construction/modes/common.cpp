@@ -5,7 +5,8 @@
 #include <move_r/move_r.hpp>
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::preprocess_t(bool in_memory, bool bigbwt, std::ifstream* T_ifile)
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::preprocess_t(bool in_memory, bool bigbwt, std::ifstream* T_ifile)
 {
     if (log)
         std::cout << "preprocessing T" << std::flush;
@@ -135,6 +136,9 @@ void move_r<support, sym_t, pos_t>::construction::preprocess_t(bool in_memory, b
 
             // Apply map_symbol to T.
             if (in_memory) {
+                // if T is memory-mapped, the mapping becomes a private copy-on-write mapping
+                if (T_mmap.data != NULL) mprotect(T_mmap.data, T_mmap.size, PROT_READ | PROT_WRITE);
+
                 #pragma omp parallel for num_threads(p)
                 for (uint64_t i = 0; i < n - 1; i++) {
                     if (T<i_sym_t>(i) <= max_remapped_uchar) {
@@ -174,49 +178,79 @@ void move_r<support, sym_t, pos_t>::construction::preprocess_t(bool in_memory, b
         }
 
         p_ = p;
-    } else if (idx.sigma == 0) {
-        idx.symbols_remapped = true;
-        uint64_t alloc_before = malloc_count_current();
+    } else {
+        if (idx.sigma == 0) {
+            idx.symbols_remapped = true;
 
-        for (pos_t i = 0; i < n - 1; i++) {
-            idx._map_int.try_emplace(T<sym_t>(i), 0);
-        }
+            /* To compact the alphabet of T[0..n-2], we sort a copy of T[0..n-2] in parallel and extract its distinct
+            symbols in ascending order into map_ext[1..sigma-1]; like this, only the sigma-1 distinct symbols have to be
+            inserted into map_int, instead of all n-1 symbols of T[0..n-2]. */
+            std::vector<sym_t> T_sorted;
+            no_init_resize(T_sorted, n - 1);
 
-        idx.sigma = idx._map_int.size() + 1;
-        idx.size_map_int = malloc_count_current() - alloc_before;
-        p_ = 1;
-        no_init_resize(idx._map_ext, idx.sigma);
-        idx._map_ext[0] = 0;
-        pos_t sym_cur = 1;
+            #pragma omp parallel for num_threads(p)
+            for (uint64_t i = 0; i < n - 1; i++) {
+                T_sorted[i] = T<sym_t>(i);
+            }
 
-        for (auto p : idx._map_int) {
-            idx._map_ext[sym_cur] = p.first;
-            sym_cur++;
-        }
+            if (p == 1) {
+                ips4o::sort(T_sorted.begin(), T_sorted.end());
+            } else {
+                ips4o::parallel::sort(T_sorted.begin(), T_sorted.end(), std::less<>(), p);
+            }
 
-        if (p == 1) {
-            ips4o::sort(idx._map_ext.begin() + 1, idx._map_ext.end());
-        } else {
-            ips4o::parallel::sort(idx._map_ext.begin() + 1, idx._map_ext.end());
-        }
+            // [0..p], d_p[i_p] = number of distinct symbols starting in T_sorted before thread i_p's section
+            std::vector<pos_t> d_p(p + 1, 0);
 
-        if (idx.sigma > p) {
             #pragma omp parallel num_threads(p)
             {
                 uint16_t i_p = omp_get_thread_num();
+                pos_t b = i_p * ((n - 1) / p);
+                pos_t e = i_p == p - 1 ? n - 1 : (i_p + 1) * ((n - 1) / p);
+                pos_t num_syms = 0;
+
+                for (pos_t i = b; i < e; i++) {
+                    if (i == 0 || T_sorted[i - 1] != T_sorted[i]) {
+                        num_syms++;
+                    }
+                }
+
+                d_p[i_p + 1] = num_syms;
 
-                i_sym_t b = 1 + i_p * ((idx.sigma - 1) / p);
-                i_sym_t e = i_p == p - 1 ? idx.sigma - 1 : ((i_p + 1) * ((idx.sigma - 1) / p));
+                #pragma omp barrier
+                #pragma omp single
+                {
+                    for (uint16_t i = 1; i <= p; i++) {
+                        d_p[i] += d_p[i - 1];
+                    }
+
+                    idx.sigma = d_p[p] + 1;
+                    no_init_resize(idx._map_ext, idx.sigma);
+                    idx._map_ext[0] = 0;
+                }
 
-                for (i_sym_t i = b; i <= e; i++) {
-                    idx._map_int[idx._map_ext[i]] = i;
+                i_sym_t sym_cur = d_p[i_p] + 1;
+
+                for (pos_t i = b; i < e; i++) {
+                    if (i == 0 || T_sorted[i - 1] != T_sorted[i]) {
+                        idx._map_ext[sym_cur] = T_sorted[i];
+                        sym_cur++;
+                    }
                 }
             }
-        } else {
+
+            T_sorted.clear();
+            T_sorted.shrink_to_fit();
+
+            idx._map_int.reserve(idx.sigma - 1);
+
             for (i_sym_t i = 1; i < idx.sigma; i++) {
-                idx._map_int[idx._map_ext[i]] = i;
+                idx._map_int.emplace(idx._map_ext[i], i);
             }
         }
+
+        // the RLBWT and I_LF are built without per-thread C-arrays for integer alphabets, hence p' is not limited by sigma
+        p_ = p;
     }
 
     if (log) {
@@ -227,8 +261,9 @@ void move_r<support, sym_t, pos_t>::construction::preprocess_t(bool in_memory, b
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
 template <rlbwt_build_mode mode, typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_rlbwt_c()
 {
     if (log) {
         time = now();
@@ -245,14 +280,6 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
         C.resize(p_, std::vector<pos_t>(byte_alphabet ? 256 : idx.sigma, 0));
     }
 
-    if constexpr (mode == _bwt_file) {
-        for (uint16_t i = 0; i < p; i++) {
-            BWT_file_bufs.emplace_back(sdsl::int_vector_buffer<8>(
-                prefix_tmp_files + ".bwt", std::ios::in,
-                128 * 1024, 8, true));
-        }
-    }
-
     for (uint16_t i = 0; i < p_; i++) {
         n_p.emplace_back(i * (n / p_));
     }
@@ -279,10 +306,6 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
             prev_sym = SA[b] == 0 ? 0 : T<i_sym_t>(SA[b] - 1);
         } else if constexpr (mode == _bwt) {
             prev_sym = char_to_uchar(L[b]);
-        } else if constexpr (mode == _bwt_file) {
-            prev_sym = BWT_file_bufs[i_p][b];
-            if (prev_sym == 2)
-                prev_sym = 0;
         }
 
         // Iterate over the range L[b+1..e-1]
@@ -291,10 +314,6 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
                 cur_sym = SA[i] == 0 ? 0 : T<i_sym_t>(SA[i] - 1);
             } else if constexpr (mode == _bwt) {
                 cur_sym = char_to_uchar(L[i]);
-            } else if constexpr (mode == _bwt_file) {
-                cur_sym = BWT_file_bufs[i_p][i];
-                if (cur_sym == 2)
-                    cur_sym = 0;
             }
 
             // check if there is a run starting at L[i]
@@ -316,6 +335,38 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
         RLBWT[i_p].shrink_to_fit();
     }
 
+    if (&L == &L_tmp) {
+        L.clear();
+        L.shrink_to_fit();
+    }
+
+    if (delete_T) {
+        T_str.clear();
+        T_str.shrink_to_fit();
+        unmap_t_file();
+        T_vec.clear();
+        T_vec.shrink_to_fit();
+    }
+
+    if (support == _count && mode != _bwt) {
+        SA.clear();
+        SA.shrink_to_fit();
+    }
+
+    merge_rlbwt_sections();
+    if constexpr (byte_alphabet) process_c();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_build_rlbwt=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::merge_rlbwt_sections()
+{
     // for i_p \in [1,p'-2], merge the last run in thread i_p's section with the first run in thread
     // i_p+1's section, if their characters are equal
     for (uint16_t i_p = 0; i_p < p_ - 1; i_p++) {
@@ -336,33 +387,6 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
         }
     }
 
-    if constexpr (mode == _bwt_file) {
-        for (uint16_t i = 0; i < p; i++) {
-            BWT_file_bufs[i].close();
-        }
-
-        BWT_file_bufs.clear();
-        BWT_file_bufs.shrink_to_fit();
-        std::filesystem::remove(prefix_tmp_files + ".bwt");
-    }
-
-    if (&L == &L_tmp) {
-        L.clear();
-        L.shrink_to_fit();
-    }
-
-    if (delete_T) {
-        T_str.clear();
-        T_str.shrink_to_fit();
-        T_vec.clear();
-        T_vec.shrink_to_fit();
-    }
-
-    if (support == _count && mode != _bwt) {
-        SA.clear();
-        SA.shrink_to_fit();
-    }
-
     /* Now, r_p[i_p] stores the number of runs starting in the iteration range L[b..e] of thread
     i_p in [0..p'-1], and r_p[p'] = 0. We want r_p[i_p] to store the number of runs starting before
     the iteration range start position b of thread i_p in [0..p'-1]. Also, we want r_p[p'] to store
@@ -384,26 +408,11 @@ void move_r<support, sym_t, pos_t>::construction::build_rlbwt_c()
 
     r = r_p[p_];
     idx.r = r;
-
-    if constexpr (int_alphabet) {
-        C.emplace_back(std::vector<pos_t>(idx.sigma, 0));
-
-        for (pos_t i = 0; i < r; i++) {
-            C[0][run_sym(0, i)] += run_len(0, i);
-        }
-    }
-
-    process_c();
-
-    if (log) {
-        if (mf_idx != NULL)
-            *mf_idx << " time_build_rlbwt=" << time_diff_ns(time, now());
-        time = log_runtime(time);
-    }
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::process_c()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::process_c()
 {
     /* Now, C[i_p][c] is the number of occurrences of c in L[b..e], where [b..e] is the range of the
     thread i_p in [0..p'-1]. Also, we have C[p'][0..255] = 0. */
@@ -450,7 +459,8 @@ void move_r<support, sym_t, pos_t>::construction::process_c()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_ilf()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_ilf()
 {
     if (log) {
         time = now();
@@ -459,37 +469,112 @@ void move_r<support, sym_t, pos_t>::construction::build_ilf()
 
     no_init_resize(I_LF, r);
 
-    #pragma omp parallel num_threads(p_)
-    {
-        // Index in [0..p'-1] of the current thread.
-        uint16_t i_p = omp_get_thread_num();
+    if constexpr (byte_alphabet) {
+        #pragma omp parallel num_threads(p_)
+        {
+            // Index in [0..p'-1] of the current thread.
+            uint16_t i_p = omp_get_thread_num();
 
-        // Iteration range start position of thread i_p.
-        pos_t b_r = r_p[i_p];
+            // Iteration range start position of thread i_p.
+            pos_t b_r = r_p[i_p];
 
-        // Number of BWT runs in thread i_p's section.
-        pos_t rp_diff = r_p[i_p + 1] - r_p[i_p];
+            // Number of BWT runs in thread i_p's section.
+            pos_t rp_diff = r_p[i_p + 1] - r_p[i_p];
 
-        // i', Start position of the last-seen run.
-        pos_t i_ = n_p[i_p];
+            // i', Start position of the last-seen run.
+            pos_t i_ = n_p[i_p];
 
-        // Build I_LF
-        for (pos_t i = 0; i < rp_diff; i++) {
-            /* Write the pair (i',LF(i')) to the next position i in I_LF, where
-            LF(i') = C[L[i']] + rank(L,L[i'],i'-1) = C[p'][L[i']] + C[i_p][L[i']]. */
-            I_LF[b_r + i] = std::make_pair(i_, C[p_][run_sym(i_p, i)] + C[i_p][run_sym(i_p, i)]);
+            // Build I_LF
+            for (pos_t i = 0; i < rp_diff; i++) {
+                /* Write the pair (i',LF(i')) to the next position i in I_LF, where
+                LF(i') = C[L[i']] + rank(L,L[i'],i'-1) = C[p'][L[i']] + C[i_p][L[i']]. */
+                I_LF[b_r + i] = std::make_pair(i_, C[p_][run_sym(i_p, i)] + C[i_p][run_sym(i_p, i)]);
 
-            /* Update the rank-function in C[i_p] to store C[i_p][c] = rank(L,c,i'-1),
-            for each c in [0..255] */
-            C[i_p][run_sym(i_p, i)] += run_len(i_p, i);
+                /* Update the rank-function in C[i_p] to store C[i_p][c] = rank(L,c,i'-1),
+                for each c in [0..255] */
+                C[i_p][run_sym(i_p, i)] += run_len(i_p, i);
 
-            // Update the position of the last-seen run.
-            i_ += run_len(i_p, i);
+                // Update the position of the last-seen run.
+                i_ += run_len(i_p, i);
+            }
         }
-    }
 
-    C.clear();
-    C.shrink_to_fit();
+        C.clear();
+        C.shrink_to_fit();
+    } else {
+        /* For integer alphabets, the per-thread C-arrays would need (p'+1)*sigma words. Instead, we sort the BWT runs
+        by their symbols (and by their positions in L); since LF maps the runs with equal symbols to consecutive
+        positions in the order of their positions in L and the runs with smaller symbols to smaller positions, LF of the
+        starting position of a run is the sum of the lengths of all runs preceding it in this order. */
+
+        // [0..r-1], runs[k] = (L[i'], k), where i' is the starting position of the k-th BWT run
+        std::vector<std::pair<i_sym_t, pos_t>> runs;
+        no_init_resize(runs, r);
+
+        #pragma omp parallel num_threads(p_)
+        {
+            // Index in [0..p'-1] of the current thread.
+            uint16_t i_p = omp_get_thread_num();
+
+            // Iteration range start position of thread i_p.
+            pos_t b_r = r_p[i_p];
+
+            // Number of BWT runs in thread i_p's section.
+            pos_t rp_diff = r_p[i_p + 1] - r_p[i_p];
+
+            // i', Start position of the last-seen run.
+            pos_t i_ = n_p[i_p];
+
+            for (pos_t i = 0; i < rp_diff; i++) {
+                runs[b_r + i] = std::make_pair(run_sym(i_p, i), b_r + i);
+                I_LF[b_r + i].first = i_;
+                i_ += run_len(i_p, i);
+            }
+        }
+
+        if (p == 1) {
+            ips4o::sort(runs.begin(), runs.end());
+        } else {
+            ips4o::parallel::sort(runs.begin(), runs.end(), std::less<>(), p);
+        }
+
+        // length of the k-th BWT run
+        auto len = [&](pos_t k) { return (k == r - 1 ? n : I_LF[k + 1].first) - I_LF[k].first; };
+
+        // [0..p], len_p[i_p] = sum of the lengths of the runs in runs[0..b-1], where b is the start of thread i_p's section
+        std::vector<pos_t> len_p(p + 1, 0);
+
+        #pragma omp parallel num_threads(p)
+        {
+            uint16_t i_p = omp_get_thread_num();
+            pos_t b = i_p * (r / p);
+            pos_t e = i_p == p - 1 ? r : (i_p + 1) * (r / p);
+            pos_t len_sum = 0;
+
+            for (pos_t j = b; j < e; j++) {
+                len_sum += len(runs[j].second);
+            }
+
+            len_p[i_p + 1] = len_sum;
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                for (uint16_t i = 1; i <= p; i++) {
+                    len_p[i] += len_p[i - 1];
+                }
+            }
+
+            // LF(i') of the starting position i' of the next run in runs[b..e-1]
+            pos_t lf = len_p[i_p];
+
+            for (pos_t j = b; j < e; j++) {
+                pos_t k = runs[j].second;
+                I_LF[k].second = lf;
+                lf += len(k);
+            }
+        }
+    }
 
     if (log) {
         if (mf_idx != NULL)
@@ -499,14 +584,15 @@ void move_r<support, sym_t, pos_t>::construction::build_ilf()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_mlf()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_mlf(uint16_t p_mlf)
 {
     if (log) {
         if (mf_mds != NULL) {
             *mf_mds << "RESULT"
                     << " type=build_mlf"
                     << " text=" << name_text_file
-                    << " num_threads=" << p
+                    << " num_threads=" << p_mlf
                     << " a=" << idx.a;
         }
         time = now();
@@ -519,7 +605,7 @@ void move_r<support, sym_t, pos_t>::construction::build_mlf()
 
     idx._M_LF = move_data_structure_l_<pos_t, i_sym_t>(
         std::move(I_LF), n, {
-            .num_threads = p,
+            .num_threads = p_mlf,
             .a = idx.a,
             .log = log,
             .mf = mf_mds,
@@ -541,18 +627,19 @@ void move_r<support, sym_t, pos_t>::construction::build_mlf()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-template <bool bigbwt, typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_iphim1_sa()
+template <typename pck_t>
+template <bool sa_file, typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_iphim1_sa()
 {
     if (log) {
         time = now();
         std::cout << "building I_Phi^{-1}" << std::flush;
     }
 
-    if constexpr (bigbwt) {
+    if constexpr (sa_file) {
         for (uint16_t i = 0; i < p; i++) {
             SA_file_bufs.emplace_back(sdsl::int_vector_buffer<40>(
-                prefix_tmp_files + ".sa", std::ios::in,
+                path_sa_file, std::ios::in,
                 128 * 1024, 40, true));
         }
     }
@@ -560,8 +647,8 @@ void move_r<support, sym_t, pos_t>::construction::build_iphim1_sa()
     no_init_resize(I_Phi_m1, r);
 
     I_Phi_m1[0] = std::make_pair(
-        SA<bigbwt, sa_sint_t>(0, n - 1),
-        SA<bigbwt, sa_sint_t>(0, 0));
+        SA<sa_file, sa_sint_t>(0, n - 1),
+        SA<sa_file, sa_sint_t>(0, 0));
 
     #pragma omp parallel num_threads(p_)
     {
@@ -579,23 +666,23 @@ void move_r<support, sym_t, pos_t>::construction::build_iphim1_sa()
         if (rp_diff > 0) {
             if (r_p[i_p] != 0) {
                 I_Phi_m1[b_r] = std::make_pair(
-                    SA<bigbwt, sa_sint_t>(i_p, j - 1),
-                    SA<bigbwt, sa_sint_t>(i_p, j));
+                    SA<sa_file, sa_sint_t>(i_p, j - 1),
+                    SA<sa_file, sa_sint_t>(i_p, j));
             }
 
             j += run_len(i_p, 0);
 
             for (pos_t i = 1; i < rp_diff; i++) {
                 I_Phi_m1[b_r + i] = std::make_pair(
-                    SA<bigbwt, sa_sint_t>(i_p, j - 1),
-                    SA<bigbwt, sa_sint_t>(i_p, j));
+                    SA<sa_file, sa_sint_t>(i_p, j - 1),
+                    SA<sa_file, sa_sint_t>(i_p, j));
 
                 j += run_len(i_p, i);
             }
         }
     }
 
-    if (!build_sa_and_l && support != _locate_rlzdsa) {
+    if (!build_sa_and_l && !has_rlzdsa) {
         std::vector<sa_sint_t>& SA = get_sa<sa_sint_t>(); // [0..n-1] The suffix array
 
         SA.clear();
@@ -610,8 +697,9 @@ void move_r<support, sym_t, pos_t>::construction::build_iphim1_sa()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
 template <bool build_sas_>
-void move_r<support, sym_t, pos_t>::construction::build_l__sas()
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_l__sas()
 {
     if (log) {
         time = now();
@@ -619,7 +707,7 @@ void move_r<support, sym_t, pos_t>::construction::build_l__sas()
     }
 
     if constexpr (build_sas_) {
-        if constexpr (support == _locate_move) {
+        if constexpr (has_m_phi_m1) {
             no_init_resize(SA_s, r_);
         } else {
             idx._SA_s.resize_no_init(r_);
@@ -649,7 +737,7 @@ void move_r<support, sym_t, pos_t>::construction::build_l__sas()
         for (pos_t i = 0; i < rp_diff; i++) {
             idx._M_LF.template set_L_(j, run_sym(i_p, i));
             if constexpr (build_sas_) {
-                if constexpr (support == _locate_move) {
+                if constexpr (has_m_phi_m1) {
                     SA_s[j] = I_Phi_m1[b_r + i].second;
                 } else {
                     idx._SA_s.template set<0, pos_t>(j, I_Phi_m1[b_r + i].second);
@@ -665,7 +753,7 @@ void move_r<support, sym_t, pos_t>::construction::build_l__sas()
             // created by the balancing algorithm
             while (idx._M_LF.p(j) < l_) {
                 if constexpr (build_sas_) {
-                    if constexpr (support == _locate_move) {
+                    if constexpr (has_m_phi_m1) {
                         SA_s[j] = n;
                     } else {
                         idx._SA_s.template set<0, pos_t>(j, n);
@@ -695,19 +783,20 @@ void move_r<support, sym_t, pos_t>::construction::build_l__sas()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::sort_iphim1()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::sort_iphim1(uint16_t p_sort)
 {
     if (log) {
         time = now();
         std::cout << "sorting I_Phi^{-1}" << std::flush;
     }
 
-    // Sort I_Phi^{-1} by the starting positions of its input intervals.
-    auto comp_I_Phi = [](std::pair<pos_t, pos_t> p1, std::pair<pos_t, pos_t> p2) { return p1.first < p2.first; };
+    // Sort I_Phi^{-1} by the starting positions of its input intervals (directly on the packed pairs).
+    auto comp_I_Phi = [](const std::pair<pck_t, pck_t>& p1, const std::pair<pck_t, pck_t>& p2) { return p1.first < p2.first; };
 
     // Choose the correct sorting algorithm.
-    if (p > 1) {
-        ips4o::parallel::sort(I_Phi_m1.begin(), I_Phi_m1.end(), comp_I_Phi);
+    if (p_sort > 1) {
+        ips4o::parallel::sort(I_Phi_m1.begin(), I_Phi_m1.end(), comp_I_Phi, p_sort);
     } else {
         ips4o::sort(I_Phi_m1.begin(), I_Phi_m1.end(), comp_I_Phi);
     }
@@ -727,7 +816,8 @@ void move_r<support, sym_t, pos_t>::construction::sort_iphim1()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_mphim1()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_mphim1(uint16_t p_mphi)
 {
     if (log) {
         time = now();
@@ -737,7 +827,7 @@ void move_r<support, sym_t, pos_t>::construction::build_mphim1()
 
     idx._M_Phi_m1 = move_data_structure<pos_t>(
         std::move(I_Phi_m1), n, {
-            .num_threads = p,
+            .num_threads = p_mphi,
             .a = idx.a,
             .log = log,
             .mf = mf_mds,
@@ -759,7 +849,8 @@ void move_r<support, sym_t, pos_t>::construction::build_mphim1()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_saphim1()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_saphim1()
 {
     time = now();
     if (log)
@@ -774,7 +865,7 @@ void move_r<support, sym_t, pos_t>::construction::build_saphim1()
 
     auto comp_pi_ = [this](pos_t i, pos_t j) { return SA_s[i] < SA_s[j]; };
     if (p > 1) {
-        ips4o::parallel::sort(pi_.begin(), pi_.end(), comp_pi_);
+        ips4o::parallel::sort(pi_.begin(), pi_.end(), comp_pi_, p);
     } else {
         ips4o::sort(pi_.begin(), pi_.end(), comp_pi_);
     }
@@ -945,7 +1036,8 @@ void move_r<support, sym_t, pos_t>::construction::build_saphim1()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_de()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_de()
 {
     if constexpr (supports_locate) {
         idx.p_r = std::min<pos_t>(256, std::max<pos_t>(1, r / 100));
@@ -967,17 +1059,22 @@ void move_r<support, sym_t, pos_t>::construction::build_de()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_rsl_()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_rsl_(uint16_t p_rsl)
 {
     if (log) {
         time = now();
         std::cout << "building RS_L'" << std::flush;
     }
 
+    // read L' directly from M_LF
+    const move_data_structure_l_<pos_t, i_sym_t>& M_LF = idx._M_LF;
+    auto read_l_ = [&M_LF](pos_t x) { return M_LF.L_(x); };
+
     if constexpr (byte_alphabet) {
-        idx._RS_L_ = rsl_t([this](pos_t i) { return idx.L_(i); }, 0, r_ - 1);
+        idx._RS_L_ = rsl_t(read_l_, 0, r_ - 1, p_rsl);
     } else {
-        idx._RS_L_ = rsl_t([this](pos_t i) { return idx.L_(i); }, idx.sigma, 0, r_ - 1);
+        idx._RS_L_ = rsl_t(read_l_, idx.sigma, 0, r_ - 1, p_rsl);
     }
 
     if (log) {
@@ -988,7 +1085,8 @@ void move_r<support, sym_t, pos_t>::construction::build_rsl_()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_rlbwt()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_rlbwt()
 {
     if (log) {
         time = now();
@@ -1013,7 +1111,8 @@ void move_r<support, sym_t, pos_t>::construction::store_rlbwt()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_rlbwt()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_rlbwt()
 {
     if (log) {
         time = now();
@@ -1038,7 +1137,8 @@ void move_r<support, sym_t, pos_t>::construction::load_rlbwt()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_mlf()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_mlf()
 {
     if (log) {
         time = now();
@@ -1058,7 +1158,8 @@ void move_r<support, sym_t, pos_t>::construction::store_mlf()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_mlf()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_mlf()
 {
     if (log) {
         time = now();
@@ -1078,7 +1179,8 @@ void move_r<support, sym_t, pos_t>::construction::load_mlf()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_sas()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_sas()
 {
     if (log) {
         time = now();
@@ -1086,7 +1188,7 @@ void move_r<support, sym_t, pos_t>::construction::store_sas()
     }
 
     std::ofstream file_sas(prefix_tmp_files + ".sas");
-    write_to_file(file_sas, (char*)&SA_s[0], r_ * sizeof(pos_t));
+    write_to_file(file_sas, (char*)&SA_s[0], r_ * sizeof(pck_t));
     SA_s.clear();
     SA_s.shrink_to_fit();
     file_sas.close();
@@ -1097,7 +1199,8 @@ void move_r<support, sym_t, pos_t>::construction::store_sas()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_sas()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_sas()
 {
     if (log) {
         time = now();
@@ -1106,7 +1209,7 @@ void move_r<support, sym_t, pos_t>::construction::load_sas()
 
     std::ifstream file_sas(prefix_tmp_files + ".sas");
     no_init_resize(SA_s, r_);
-    read_from_file(file_sas, (char*)&SA_s[0], r_ * sizeof(pos_t));
+    read_from_file(file_sas, (char*)&SA_s[0], r_ * sizeof(pck_t));
     file_sas.close();
     std::filesystem::remove(prefix_tmp_files + ".sas");
 
@@ -1116,7 +1219,8 @@ void move_r<support, sym_t, pos_t>::construction::load_sas()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_sas_idx()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_sas_idx()
 {
     if (log) {
         time = now();
@@ -1135,7 +1239,8 @@ void move_r<support, sym_t, pos_t>::construction::store_sas_idx()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_sas_idx()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_sas_idx()
 {
     if (log) {
         time = now();
@@ -1153,7 +1258,8 @@ void move_r<support, sym_t, pos_t>::construction::load_sas_idx()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_rsl_()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_rsl_()
 {
     if (log) {
         time = now();
@@ -1171,7 +1277,8 @@ void move_r<support, sym_t, pos_t>::construction::store_rsl_()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_rsl_()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_rsl_()
 {
     if (log) {
         time = now();
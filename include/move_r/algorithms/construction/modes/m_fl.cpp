@@ -0,0 +1,36 @@
+#pragma once
+
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::build_m_fl(uint16_t num_threads)
+{
+    uint16_t p = std::max<uint16_t>(1, num_threads);
+
+    // I_FL = (q_0, p_0), (q_1, p_1), ..., (q_{r'-1}, p_{r'-1}) sorted by the output interval starting positions of M_LF
+    std::vector<std::pair<pos_t, pos_t>> I_FL;
+    no_init_resize(I_FL, r_);
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t x = 0; x < r_; x++) {
+        I_FL[x] = std::make_pair(_M_LF.q(x), _M_LF.p(x));
+    }
+
+    auto comp_q = [](const std::pair<pos_t, pos_t>& p1, const std::pair<pos_t, pos_t>& p2) { return p1.first < p2.first; };
+
+    if (p > 1) {
+        ips4o::parallel::sort(I_FL.begin(), I_FL.end(), comp_q, p);
+    } else {
+        ips4o::sort(I_FL.begin(), I_FL.end(), comp_q);
+    }
+
+    _M_FL = move_data_structure_l_<pos_t, i_sym_t>(std::move(I_FL), n, { .num_threads = p, .a = a }, _M_LF.width_l_());
+    pos_t r_fl = _M_FL.num_intervals();
+
+    // F'[x] = F[i] = L[FL(i)] for i = M_FL.p(x)
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t x = 0; x < r_fl; x++) {
+        pos_t j = _M_FL.q(x);
+        _M_FL.set_L_(x, _M_LF.L_(bin_search_max_leq<pos_t>(j, 0, r_ - 1, [this](pos_t y) { return _M_LF.p(y); })));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <bit>
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::build_m_lf_k(uint8_t k, uint16_t num_threads)
+{
+    k_lf = std::bit_floor(std::max<uint8_t>(1, k));
+    _M_LF_k = move_data_structure<pos_t>();
+    _L_k.clear();
+    _L_k.shrink_to_fit();
+
+    if (k_lf == 1) {
+        return;
+    }
+
+    uint16_t p = std::max<uint16_t>(1, num_threads);
+
+    /* returns the disjoint interval sequence of f_J(f_I(i)), where I and J are disjoint interval sequences over [0..n)
+    sorted by their input interval starting positions; each output interval [q_i, q_i + d_i) of I is split at the
+    starting positions of the input intervals of J inside it, hence the result has at most |I| + |J| intervals */
+    auto compose = [&](std::vector<std::pair<pos_t, pos_t>>& I, std::vector<std::pair<pos_t, pos_t>>& J) {
+        pos_t k_I = I.size();
+        pos_t k_J = J.size();
+        std::vector<std::pair<pos_t, pos_t>> IJ;
+        // [0..p], k_p[i_p] = number of pairs created out of the pairs in I before thread i_p's section
+        std::vector<pos_t> k_p(p + 1, 0);
+
+        #pragma omp parallel num_threads(p)
+        {
+            uint16_t i_p = omp_get_thread_num();
+
+            pos_t b = i_p * (k_I / p);
+            pos_t e = i_p == p - 1 ? k_I : (i_p + 1) * (k_I / p);
+
+            // splits the output intervals of I[b..e-1] and writes the resulting pairs to IJ[o..], if write = true
+            auto split = [&](bool write, pos_t o) {
+                pos_t num_pairs = 0;
+
+                for (pos_t i = b; i < e; i++) {
+                    pos_t q_i = I[i].second;
+                    pos_t qi_pd = q_i + ((i == k_I - 1 ? n : I[i + 1].first) - I[i].first);
+                    // index of the input interval of J containing q_i
+                    pos_t j = bin_search_max_leq<pos_t>(q_i, 0, k_J - 1, [&J](pos_t x) { return J[x].first; });
+
+                    do {
+                        pos_t s = std::max(q_i, J[j].first);
+
+                        if (write) {
+                            IJ[o + num_pairs] = std::make_pair(I[i].first + (s - q_i), J[j].second + (s - J[j].first));
+                        }
+
+                        num_pairs++;
+                        j++;
+                    } while (j < k_J && J[j].first < qi_pd);
+                }
+
+                return num_pairs;
+            };
+
+            k_p[i_p + 1] = split(false, 0);
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                for (uint16_t i = 1; i <= p; i++) {
+                    k_p[i] += k_p[i - 1];
+                }
+
+                no_init_resize(IJ, k_p[p]);
+            }
+
+            split(true, k_p[i_p]);
+        }
+
+        return IJ;
+    };
+
+    // I_LF^1 consists of the intervals of M_LF
+    std::vector<std::pair<pos_t, pos_t>> I_LF_k;
+    no_init_resize(I_LF_k, r_);
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t x = 0; x < r_; x++) {
+        I_LF_k[x] = std::make_pair(_M_LF.p(x), _M_LF.q(x));
+    }
+
+    // I_LF^{2t} = I_LF^t composed with itself
+    for (uint8_t t = 1; t < k_lf; t *= 2) {
+        I_LF_k = compose(I_LF_k, I_LF_k);
+    }
+
+    _M_LF_k = move_data_structure<pos_t>(std::move(I_LF_k), n, { .num_threads = p, .a = a });
+    pos_t r_k = _M_LF_k.num_intervals();
+    no_init_resize(_L_k, k_lf * (uint64_t)r_k);
+
+    // L_k[x*k..x*k+k-1] = L[i],L[LF(i)],...,L[LF^{k-1}(i)] for i = M_LF^k.p(x)
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+
+        pos_t b = i_p * (r_k / p);
+        pos_t e = i_p == p - 1 ? r_k : (i_p + 1) * (r_k / p);
+
+        // index of the input interval of M_LF containing M_LF^k.p(x)
+        pos_t y = b == e ? 0 : bin_search_max_leq<pos_t>(_M_LF_k.p(b), 0, r_ - 1, [this](pos_t x_) { return _M_LF.p(x_); });
+
+        for (pos_t x = b; x < e; x++) {
+            pos_t i = _M_LF_k.p(x);
+
+            while (_M_LF.p(y + 1) <= i) {
+                y++;
+            }
+
+            pos_t y_ = y;
+
+            for (uint8_t t = 0; t < k_lf; t++) {
+                _L_k[x * (uint64_t)k_lf + t] = _M_LF.L_(y_);
+                _M_LF.move(i, y_);
+            }
+        }
+    }
+}
\ No newline at end of file
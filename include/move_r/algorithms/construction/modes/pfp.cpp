@@ -0,0 +1,629 @@
+#pragma once
+
+#include <filesystem>
+#include <ips4o.hpp>
+#include <libsais.h>
+#include <libsais64.h>
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::parse_t()
+{
+    if (log) {
+        time = now();
+        std::cout << "parsing T" << std::flush;
+    }
+
+    w_pfp = std::min<pos_t>(w_pfp, n - 1);
+
+    // windows starting in [0..n-w-1] do not contain T[n-1]; T[n-w..n-1] is always a trigger string
+    pos_t num_windows = n - w_pfp;
+
+    // 256^(w-1) mod prime_pfp
+    uint64_t pow_w = 1;
+
+    for (pos_t i = 1; i < w_pfp; i++) {
+        pow_w = (pow_w * 256) % prime_pfp;
+    }
+
+    // [0..p-1] starting positions of the trigger strings (except T[n-w..n-1]) found by each thread
+    std::vector<std::vector<pos_t>> S_thr(p);
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t b = i_p * (num_windows / p);
+        pos_t e = i_p == p - 1 ? num_windows : (i_p + 1) * (num_windows / p);
+
+        if (b < e) {
+            // Karp-Rabin fingerprint of T[i..i+w-1]
+            uint64_t fp = 0;
+
+            for (pos_t i = b; i < b + w_pfp; i++) {
+                fp = (fp * 256 + T<uint8_t>(i)) % prime_pfp;
+            }
+
+            for (pos_t i = b;; i++) {
+                if (fp % m_pfp == 0) {
+                    S_thr[i_p].emplace_back(i);
+                }
+
+                if (i + 1 == e) {
+                    break;
+                }
+
+                fp = ((fp + prime_pfp - (T<uint8_t>(i) * pow_w) % prime_pfp) * 256 + T<uint8_t>(i + w_pfp)) % prime_pfp;
+            }
+        }
+    }
+
+    // the 0-th phrase starts with T[n-w..n-1], the other phrases are ordered by their starting positions in T
+    S_pfp.emplace_back(n - w_pfp);
+
+    for (uint16_t i_p = 0; i_p < p; i_p++) {
+        S_pfp.insert(S_pfp.end(), S_thr[i_p].begin(), S_thr[i_p].end());
+        S_thr[i_p].clear();
+        S_thr[i_p].shrink_to_fit();
+    }
+
+    k_pfp = S_pfp.size();
+    phrase_0.reserve(phrase_len(0));
+    phrase_0.append(&T<char>(n - w_pfp), w_pfp);
+    phrase_0.append(&T<char>(0), phrase_len(0) - w_pfp);
+
+    // [0..p-1] hash maps of each thread, mapping each distinct phrase in its section to a local id
+    std::vector<emhash5::HashMap<std::string_view, pos_t>> map_thr(p);
+    // [0..p-1] the distinct phrases in each thread's section, ordered by their local ids
+    std::vector<std::vector<std::string_view>> D_thr(p);
+    no_init_resize(P_pfp, k_pfp);
+
+    // assign each phrase its local id
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t b = i_p * (k_pfp / p);
+        pos_t e = i_p == p - 1 ? k_pfp : (i_p + 1) * (k_pfp / p);
+
+        for (pos_t j = b; j < e; j++) {
+            std::string_view ph = phrase(j);
+            auto it = map_thr[i_p].find(ph);
+
+            if (it == map_thr[i_p].end()) {
+                P_pfp[j] = D_thr[i_p].size();
+                map_thr[i_p].insert_unique(ph, P_pfp[j]);
+                D_thr[i_p].emplace_back(ph);
+            } else {
+                P_pfp[j] = it->second;
+            }
+        }
+
+        map_thr[i_p].clear();
+    }
+
+    map_thr.clear();
+    map_thr.shrink_to_fit();
+
+    // sort the distinct phrases lexicographically and remove duplicates found by multiple threads
+    for (uint16_t i_p = 0; i_p < p; i_p++) {
+        D_pfp.insert(D_pfp.end(), D_thr[i_p].begin(), D_thr[i_p].end());
+    }
+
+    if (p > 1) {
+        ips4o::parallel::sort(D_pfp.begin(), D_pfp.end(), std::less<>(), p);
+    } else {
+        ips4o::sort(D_pfp.begin(), D_pfp.end());
+    }
+
+    D_pfp.erase(std::unique(D_pfp.begin(), D_pfp.end()), D_pfp.end());
+    D_pfp.shrink_to_fit();
+
+    // replace the local ids by the lexicographic ranks of the phrases
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t b = i_p * (k_pfp / p);
+        pos_t e = i_p == p - 1 ? k_pfp : (i_p + 1) * (k_pfp / p);
+
+        // rank[l] = lexicographic rank of the phrase with the local id l
+        std::vector<pos_t> rank;
+        no_init_resize(rank, D_thr[i_p].size());
+
+        for (pos_t l = 0; l < D_thr[i_p].size(); l++) {
+            rank[l] = std::lower_bound(D_pfp.begin(), D_pfp.end(), D_thr[i_p][l]) - D_pfp.begin();
+        }
+
+        for (pos_t j = b; j < e; j++) {
+            P_pfp[j] = rank[P_pfp[j]];
+        }
+
+        D_thr[i_p].clear();
+        D_thr[i_p].shrink_to_fit();
+    }
+
+    if (log) {
+        if (mf_idx != NULL) {
+            *mf_idx << " time_parse_t=" << time_diff_ns(time, now())
+                    << " num_phrases=" << k_pfp
+                    << " num_distinct_phrases=" << D_pfp.size();
+        }
+
+        time = log_runtime(time);
+        std::cout << "number of phrases: " << k_pfp << ", number of distinct phrases: " << D_pfp.size() << std::endl;
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename int_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::suffix_array_int(std::vector<int_t>& T_int, std::vector<int_t>& SA_int, int_t sigma)
+{
+    no_init_resize(SA_int, T_int.size());
+
+    if constexpr (std::is_same_v<int_t, int32_t>) {
+        libsais_int_omp(T_int.data(), SA_int.data(), T_int.size(), sigma, 0, p);
+    } else {
+        libsais64_long_omp(T_int.data(), SA_int.data(), T_int.size(), sigma, 0, p);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename int_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::sort_parse()
+{
+    if (log) {
+        time = now();
+        std::cout << "sorting the parse" << std::flush;
+    }
+
+    /* Since the 0-th phrase is the only phrase containing T[n-1] at its w-th position, the order of the rotations of
+    the parse P equals the order of the suffixes of X = P[1..k-1]P[0], where X[j] = P[(j+1) mod k]; hence, the j-th
+    phrase precedes the rotation of P that corresponds to the suffix X[j..k-1]. */
+    std::vector<int_t> X;
+    std::vector<int_t> SA_X;
+    no_init_resize(X, k_pfp);
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t j = 0; j < k_pfp; j++) {
+        X[j] = P_pfp[(j + 1) % k_pfp];
+    }
+
+    suffix_array_int<int_t>(X, SA_X, D_pfp.size());
+    X.clear();
+    X.shrink_to_fit();
+    no_init_resize(SA_P_pfp, k_pfp);
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t q = 0; q < k_pfp; q++) {
+        SA_P_pfp[q] = SA_X[q];
+    }
+
+    SA_X.clear();
+    SA_X.shrink_to_fit();
+
+    // build the inverted lists, i.e., IL[IL_b[d]..IL_b[d+1]-1] stores the increasing positions q in the BWT of P
+    // with BWT_P[q] = P[SA_P[q]] = d
+    IL_b_pfp.resize(D_pfp.size() + 1, 0);
+
+    for (pos_t q = 0; q < k_pfp; q++) {
+        IL_b_pfp[P_pfp[SA_P_pfp[q]] + 1]++;
+    }
+
+    for (pos_t d = 1; d <= D_pfp.size(); d++) {
+        IL_b_pfp[d] += IL_b_pfp[d - 1];
+    }
+
+    std::vector<pos_t> IL_e = IL_b_pfp;
+    no_init_resize(IL_pfp, k_pfp);
+
+    for (pos_t q = 0; q < k_pfp; q++) {
+        IL_pfp[IL_e[P_pfp[SA_P_pfp[q]]]++] = q;
+    }
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_sort_parse=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename int_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::sort_dictionary_suffixes()
+{
+    if (log) {
+        time = now();
+        std::cout << "sorting the suffixes of the dictionary" << std::flush;
+    }
+
+    pos_t d_pfp = D_pfp.size();
+
+    // [0..|D|] D_b[d] = starting position of the d-th phrase in D_cat
+    std::vector<uint64_t> D_b(d_pfp + 1);
+    D_b[0] = 0;
+
+    for (pos_t d = 0; d < d_pfp; d++) {
+        D_b[d + 1] = D_b[d] + D_pfp[d].size() + 1;
+    }
+
+    /* D_cat = D[0]1D[1]1...D[|D|-1]10, where each character c in D[0..|D|-1] has been replaced by c+2; the separator 1
+    is smaller than all characters, hence equal suffixes of the phrases occur consecutively in the suffix array of
+    D_cat (if we only consider suffixes of length > w) */
+    std::vector<int_t> D_cat;
+    std::vector<int_t> SA_D;
+    no_init_resize(D_cat, D_b[d_pfp] + 1);
+    D_cat[D_b[d_pfp]] = 0;
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t d = 0; d < d_pfp; d++) {
+        for (pos_t o = 0; o < D_pfp[d].size(); o++) {
+            D_cat[D_b[d] + o] = char_to_uchar(D_pfp[d][o]) + 2;
+        }
+
+        D_cat[D_b[d + 1] - 1] = 1;
+    }
+
+    suffix_array_int<int_t>(D_cat, SA_D, 258);
+    uint64_t n_D = D_cat.size();
+
+    // compute the permuted LCP array (PLCP) in place of Phi
+    std::vector<int_t> PLCP;
+    no_init_resize(PLCP, n_D);
+    PLCP[SA_D[0]] = -1;
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t i = 1; i < n_D; i++) {
+        PLCP[SA_D[i]] = SA_D[i - 1];
+    }
+
+    int_t l = 0;
+
+    for (uint64_t i = 0; i < n_D; i++) {
+        if (PLCP[i] == -1) {
+            l = 0;
+            PLCP[i] = 0;
+            continue;
+        }
+
+        uint64_t j = PLCP[i];
+
+        while (i + l < n_D && j + l < n_D && D_cat[i + l] == D_cat[j + l]) {
+            l++;
+        }
+
+        PLCP[i] = l;
+        if (l > 0) l--;
+    }
+
+    D_cat.clear();
+    D_cat.shrink_to_fit();
+
+    // iterate over the suffix array of D_cat, keep the suffixes of length > w and group equal suffixes
+    uint64_t min_lcp = 0;
+    pos_t prev_len = 0;
+
+    for (uint64_t i = 0; i < n_D; i++) {
+        min_lcp = std::min<uint64_t>(min_lcp, PLCP[SA_D[i]]);
+        uint64_t pos = SA_D[i];
+        pos_t d = std::upper_bound(D_b.begin(), D_b.end(), pos) - D_b.begin() - 1;
+
+        if (d == d_pfp) {
+            continue;
+        }
+
+        pos_t o = pos - D_b[d];
+        pos_t len = D_pfp[d].size() - o;
+
+        if (o == D_pfp[d].size() || len <= w_pfp) {
+            continue;
+        }
+
+        if (V_pfp.empty() || len != prev_len || min_lcp < len) {
+            G_pfp.emplace_back(V_pfp.size());
+        }
+
+        V_pfp.emplace_back(std::make_pair(d, o));
+        prev_len = len;
+        min_lcp = std::numeric_limits<uint64_t>::max();
+    }
+
+    G_pfp.emplace_back(V_pfp.size());
+    SA_D.clear();
+    SA_D.shrink_to_fit();
+    PLCP.clear();
+    PLCP.shrink_to_fit();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_sort_dict=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_bwt_pfp()
+{
+    if (log) {
+        time = now();
+        std::cout << "building the BWT" << (std::string)(supports_locate ? (has_rlzdsa ? " and SA" : " and I_Phi^{-1}") : "") << std::flush;
+    }
+
+    pos_t num_groups = G_pfp.size() - 1;
+
+    // [0..num_groups] O[g] = position in the BWT of the first suffix in the g-th group of equal suffixes of phrases
+    std::vector<pos_t> O(num_groups + 1);
+    O[0] = 0;
+
+    for (pos_t g = 0; g < num_groups; g++) {
+        pos_t freq = 0;
+
+        for (pos_t v = G_pfp[g]; v < G_pfp[g + 1]; v++) {
+            pos_t d = V_pfp[v].first;
+            freq += IL_b_pfp[d + 1] - IL_b_pfp[d];
+        }
+
+        O[g + 1] = O[g] + freq;
+    }
+
+    no_init_resize(L, n);
+
+    // the suffix array file stores SA[1..n-1] with 5 bytes per value (like the suffix array files output by Big-BWT)
+    if constexpr (has_rlzdsa) {
+        std::ofstream SA_file(path_sa_file);
+        SA_file.close();
+        std::filesystem::resize_file(path_sa_file, 5 * (uint64_t)(n - 1));
+    }
+
+    // [0..p-1] the pairs in I_Phi^{-1} of the run starts in each thread's section of the BWT, except at its start
+    std::vector<std::vector<std::pair<pck_t, pck_t>>> I_Phi_thr(p);
+    // [0..p-1] the first and the last BWT character in each thread's section of the BWT
+    std::vector<std::pair<uint8_t, uint8_t>> bwt_b_e(p);
+    // [0..p-1] the first and the last suffix array value in each thread's section of the BWT
+    std::vector<std::pair<pos_t, pos_t>> sa_b_e(p);
+    // [0..p] each thread iterates over the groups [g_p[i_p]..g_p[i_p+1]-1]
+    std::vector<pos_t> g_p(p + 1);
+
+    for (uint16_t i_p = 0; i_p < p; i_p++) {
+        g_p[i_p] = std::lower_bound(O.begin(), O.end() - 1, i_p * (n / p)) - O.begin();
+    }
+
+    g_p[p] = num_groups;
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t g_b = g_p[i_p];
+        pos_t g_e = std::max(g_b, g_p[i_p + 1]);
+        pos_t i = O[g_b];
+        pos_t i_b = i;
+
+        std::ofstream SA_file;
+        std::vector<char> SA_buf;
+
+        if constexpr (has_rlzdsa) {
+            SA_file.open(path_sa_file, std::ios::in | std::ios::out | std::ios::binary);
+            SA_file.seekp(5 * (uint64_t)(i == 0 ? 0 : i - 1));
+            SA_buf.reserve(5 * 128 * 1024);
+        }
+
+        uint8_t prev_c = 0; // L[i-1]
+        pos_t prev_sa = 0; // SA[i-1]
+
+        // the BWT character preceding the o-th suffix of the j-th phrase
+        auto bwt_char = [&](pos_t j, pos_t d, pos_t o) {
+            if (o > 0) return char_to_uchar(D_pfp[d][o - 1]);
+            std::string_view ph = D_pfp[P_pfp[j == 0 ? k_pfp - 1 : j - 1]];
+            return char_to_uchar(ph[ph.size() - w_pfp - 1]);
+        };
+
+        // the suffix array value of the o-th suffix of the j-th phrase
+        auto sa_val = [&](pos_t j, pos_t o) { return (pos_t)(((uint64_t)S_pfp[j] + o) % n); };
+
+        // appends the character c with the suffix array value sa to the BWT
+        auto append = [&](uint8_t c, pos_t sa) {
+            L[i] = uchar_to_char(c);
+
+            if constexpr (supports_locate) {
+                if (i == i_b) {
+                    bwt_b_e[i_p].first = c;
+                    sa_b_e[i_p].first = sa;
+                } else if constexpr (!has_rlzdsa) {
+                    if (c != prev_c) {
+                        I_Phi_thr[i_p].emplace_back(std::make_pair(prev_sa, sa));
+                    }
+                }
+
+                if constexpr (has_rlzdsa) {
+                    if (i != 0) {
+                        for (uint8_t b = 0; b < 5; b++) {
+                            SA_buf.emplace_back((char)((((uint64_t)sa) >> (8 * b)) & 0xFF));
+                        }
+
+                        if (SA_buf.size() == SA_buf.capacity()) {
+                            SA_file.write(SA_buf.data(), SA_buf.size());
+                            SA_buf.clear();
+                        }
+                    }
+                }
+            }
+
+            prev_c = c;
+            prev_sa = sa;
+            i++;
+        };
+
+        // [0..] pairs (q,v), s.t. the v-th suffix in V is preceded by the phrase BWT_P[q] in T
+        std::vector<std::pair<pos_t, pos_t>> occ;
+
+        for (pos_t g = g_b; g < g_e; g++) {
+            pos_t v_b = G_pfp[g];
+            pos_t v_e = G_pfp[g + 1];
+
+            // check if all suffixes in the group are preceded by the same character
+            bool uniform = V_pfp[v_b].second > 0;
+            uint8_t c = uniform ? char_to_uchar(D_pfp[V_pfp[v_b].first][V_pfp[v_b].second - 1]) : 0;
+
+            for (pos_t v = v_b + 1; uniform && v < v_e; v++) {
+                uniform = char_to_uchar(D_pfp[V_pfp[v].first][V_pfp[v].second - 1]) == c;
+            }
+
+            if (uniform && !has_rlzdsa) {
+                // the characters preceding the suffixes in the group form a single run, hence we only need the
+                // suffix array values at its start and end
+                pos_t q_first = k_pfp;
+                pos_t q_last = 0;
+                pos_t o_first = 0;
+                pos_t o_last = 0;
+
+                for (pos_t v = v_b; v < v_e; v++) {
+                    pos_t d = V_pfp[v].first;
+                    pos_t o = V_pfp[v].second;
+
+                    if (IL_pfp[IL_b_pfp[d]] <= q_first) {
+                        q_first = IL_pfp[IL_b_pfp[d]];
+                        o_first = o;
+                    }
+
+                    if (IL_pfp[IL_b_pfp[d + 1] - 1] >= q_last) {
+                        q_last = IL_pfp[IL_b_pfp[d + 1] - 1];
+                        o_last = o;
+                    }
+                }
+
+                pos_t len = O[g + 1] - O[g];
+                append(c, sa_val(SA_P_pfp[q_first], o_first));
+
+                if (len > 1) {
+                    std::memset(&L[i], uchar_to_char(c), len - 2);
+                    i += len - 2;
+                    append(c, sa_val(SA_P_pfp[q_last], o_last));
+                }
+            } else if (v_e - v_b == 1) {
+                // the occurrences of the suffix are ordered by the inverted list of its phrase
+                pos_t d = V_pfp[v_b].first;
+                pos_t o = V_pfp[v_b].second;
+
+                for (pos_t l = IL_b_pfp[d]; l < IL_b_pfp[d + 1]; l++) {
+                    pos_t j = SA_P_pfp[IL_pfp[l]];
+                    append(bwt_char(j, d, o), sa_val(j, o));
+                }
+            } else {
+                // merge the inverted lists of the phrases in the group
+                for (pos_t v = v_b; v < v_e; v++) {
+                    pos_t d = V_pfp[v].first;
+
+                    for (pos_t l = IL_b_pfp[d]; l < IL_b_pfp[d + 1]; l++) {
+                        occ.emplace_back(std::make_pair(IL_pfp[l], v));
+                    }
+                }
+
+                std::sort(occ.begin(), occ.end());
+
+                for (auto [q, v] : occ) {
+                    pos_t j = SA_P_pfp[q];
+                    append(bwt_char(j, V_pfp[v].first, V_pfp[v].second), sa_val(j, V_pfp[v].second));
+                }
+
+                occ.clear();
+            }
+        }
+
+        if (i != i_b) {
+            bwt_b_e[i_p].second = prev_c;
+            sa_b_e[i_p].second = prev_sa;
+        }
+
+        if constexpr (has_rlzdsa) {
+            SA_file.write(SA_buf.data(), SA_buf.size());
+            SA_file.close();
+        }
+    }
+
+    if constexpr (supports_locate && !has_rlzdsa) {
+        // I_Phi^{-1}[0] = (SA[n-1],SA[0]), the other pairs are ordered by the run starts in the BWT
+        I_Phi_m1.emplace_back(std::make_pair(0, sa_b_e[0].first));
+        int32_t prev_i_p = -1;
+
+        for (uint16_t i_p = 0; i_p < p; i_p++) {
+            if (O[g_p[i_p]] == O[std::max(g_p[i_p], g_p[i_p + 1])]) {
+                continue;
+            }
+
+            if (prev_i_p != -1 && bwt_b_e[prev_i_p].second != bwt_b_e[i_p].first) {
+                I_Phi_m1.emplace_back(std::make_pair(sa_b_e[prev_i_p].second, sa_b_e[i_p].first));
+            }
+
+            I_Phi_m1.insert(I_Phi_m1.end(), I_Phi_thr[i_p].begin(), I_Phi_thr[i_p].end());
+            I_Phi_thr[i_p].clear();
+            I_Phi_thr[i_p].shrink_to_fit();
+            prev_i_p = i_p;
+        }
+
+        I_Phi_m1[0].first = sa_b_e[prev_i_p].second;
+        I_Phi_m1.shrink_to_fit();
+    }
+
+    phrase_0.clear();
+    phrase_0.shrink_to_fit();
+    D_pfp.clear();
+    D_pfp.shrink_to_fit();
+    S_pfp.clear();
+    S_pfp.shrink_to_fit();
+    P_pfp.clear();
+    P_pfp.shrink_to_fit();
+    SA_P_pfp.clear();
+    SA_P_pfp.shrink_to_fit();
+    IL_pfp.clear();
+    IL_pfp.shrink_to_fit();
+    IL_b_pfp.clear();
+    IL_b_pfp.shrink_to_fit();
+    V_pfp.clear();
+    V_pfp.shrink_to_fit();
+    G_pfp.clear();
+    G_pfp.shrink_to_fit();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_build_bwt=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::pfp()
+{
+    parse_t();
+
+    if (k_pfp <= INT_MAX) {
+        sort_parse<int32_t>();
+    } else {
+        sort_parse<int64_t>();
+    }
+
+    uint64_t size_D_cat = D_pfp.size() + 1;
+
+    for (std::string_view& ph : D_pfp) {
+        size_D_cat += ph.size();
+    }
+
+    if (size_D_cat <= INT_MAX) {
+        sort_dictionary_suffixes<int32_t>();
+    } else {
+        sort_dictionary_suffixes<int64_t>();
+    }
+
+    build_bwt_pfp();
+
+    // T is not needed anymore (the dictionary has been deleted)
+    if (delete_T) {
+        T_str.clear();
+        T_str.shrink_to_fit();
+        unmap_t_file();
+    }
+
+    if (log) log_peak_mem_usage();
+}
\ No newline at end of file
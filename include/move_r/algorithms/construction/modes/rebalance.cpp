@@ -0,0 +1,195 @@
+#pragma once
+
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::rebalance(uint16_t a)
+{
+    extract_intervals();
+    idx.a = a;
+
+    if constexpr (has_m_phi_m1) {
+        // M_LF and M_Phi^{-1} are balanced independently of each other
+        run_phases({
+            { .name = "build_mlf", .run = [&](uint16_t p_mlf) { build_mlf(p_mlf); } },
+            { .name = "sort_iphi", .run = [&](uint16_t p_sort) { sort_iphim1(p_sort); } },
+            { .name = "build_mphi", .run = [&](uint16_t p_mphi) { build_mphim1(p_mphi); }, .deps = { 1 } }
+        });
+
+        rebuild_l__sas();
+        build_saphim1();
+        build_de();
+    } else {
+        build_mlf(p);
+        rebuild_l__sas();
+    }
+
+    build_rsl_(p);
+
+    if constexpr (support == _locate_hybrid) {
+        choose_min_occ_threshold();
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::extract_intervals()
+{
+    if (log) {
+        time = now();
+        std::cout << "extracting I_LF" << (std::string)(has_m_phi_m1 ? " and I_Phi^{-1}" : "") << std::flush;
+    }
+
+    // r' of the balanced M_LF
+    pos_t r_old = idx.r_;
+
+    // the x-th input interval of M_LF starts a BWT run <=> x = 0 or L'[x-1] != L'[x]
+    auto is_run_start = [this](pos_t x) { return x == 0 || idx.L_(x - 1) != idx.L_(x); };
+
+    r_p.resize(p + 1);
+    r_p[0] = 0;
+
+    // count the BWT runs starting in each thread's section of the input intervals of M_LF
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t x_b = i_p * (r_old / p);
+        pos_t x_e = i_p == p - 1 ? r_old : (i_p + 1) * (r_old / p);
+        pos_t num_runs = 0;
+
+        for (pos_t x = x_b; x < x_e; x++) {
+            if (is_run_start(x)) {
+                num_runs++;
+            }
+        }
+
+        r_p[i_p + 1] = num_runs;
+    }
+
+    for (uint16_t i = 1; i <= p; i++) {
+        r_p[i] += r_p[i - 1];
+    }
+
+    // the runs are maximal, so this is r (unless runs have been split when building the index)
+    r = r_p[p];
+    idx.r = r;
+
+    no_init_resize(I_LF, r);
+    no_init_resize(P_r, r + 1);
+    no_init_resize(L_r, r);
+    P_r[r] = n;
+
+    if constexpr (supports_locate) {
+        no_init_resize(SA_r, r);
+    }
+
+    if constexpr (has_m_phi_m1) {
+        no_init_resize(I_Phi_m1, r);
+    }
+
+    /* the k-th BWT run starts at the x-th input interval of M_LF; then, I_LF[k] = (M_LF.p(x),M_LF.q(x)) and, since
+       SA_Phi^{-1}[x] is the index of the pair in M_Phi^{-1} whose output interval starts with SA[M_LF.p(x)] and whose
+       input interval starts with SA[M_LF.p(x)-1], I_Phi^{-1}[k] = (M_Phi^{-1}.p(y),M_Phi^{-1}.q(y)) with y = SA_Phi^{-1}[x],
+       where I_Phi^{-1} is ordered by the BWT runs (like after build_iphim1_sa()) */
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t x_b = i_p * (r_old / p);
+        pos_t x_e = i_p == p - 1 ? r_old : (i_p + 1) * (r_old / p);
+        pos_t k = r_p[i_p];
+
+        for (pos_t x = x_b; x < x_e; x++) {
+            if (is_run_start(x)) {
+                I_LF[k] = std::make_pair(idx._M_LF.p(x), idx._M_LF.q(x));
+                P_r[k] = idx._M_LF.p(x);
+                L_r[k] = idx.L_(x);
+
+                if constexpr (supports_locate) {
+                    SA_r[k] = idx.SA_s(x);
+                }
+
+                if constexpr (has_m_phi_m1) {
+                    pos_t y = idx.SA_Phi_m1(x);
+                    I_Phi_m1[k] = std::make_pair(idx._M_Phi_m1.p(y), idx._M_Phi_m1.q(y));
+                }
+
+                k++;
+            }
+        }
+    }
+
+    if constexpr (has_m_phi_m1) {
+        idx._M_Phi_m1 = move_data_structure<pos_t>();
+        idx._SA_Phi_m1 = interleaved_vectors<pos_t, pos_t>();
+    }
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_extract_intervals=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::rebuild_l__sas()
+{
+    if (log) {
+        time = now();
+        std::cout << "building L'" << (std::string)(supports_locate ? " and SA_s" : "") << std::flush;
+    }
+
+    if constexpr (supports_locate) {
+        if constexpr (has_m_phi_m1) {
+            no_init_resize(SA_s, r_);
+        } else {
+            idx._SA_s.resize_no_init(r_);
+        }
+    }
+
+    // iterate over the BWT runs and the input intervals of M_LF simultaneously
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t k_b = i_p * (r / p);
+        pos_t k_e = i_p == p - 1 ? r : (i_p + 1) * (r / p);
+
+        // index of the input interval in M_LF starting with the k_b-th BWT run
+        pos_t x = bin_search_max_leq<pos_t>(P_r[k_b], 0, r_ - 1, [this](pos_t x_) { return idx._M_LF.p(x_); });
+
+        for (pos_t k = k_b; k < k_e; k++) {
+            // iterate over all input intervals in M_LF within the k-th bwt run
+            do {
+                idx._M_LF.template set_L_(x, L_r[k]);
+
+                if constexpr (supports_locate) {
+                    pos_t sa_s = idx._M_LF.p(x) == P_r[k] ? SA_r[k] : n;
+
+                    if constexpr (has_m_phi_m1) {
+                        SA_s[x] = sa_s;
+                    } else {
+                        idx._SA_s.template set<0, pos_t>(x, sa_s);
+                    }
+                }
+
+                x++;
+            } while (idx._M_LF.p(x) < P_r[k + 1]);
+        }
+    }
+
+    P_r.clear();
+    P_r.shrink_to_fit();
+
+    L_r.clear();
+    L_r.shrink_to_fit();
+
+    SA_r.clear();
+    SA_r.shrink_to_fit();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_build_l__sas=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
\ No newline at end of file
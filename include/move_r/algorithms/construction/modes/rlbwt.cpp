@@ -0,0 +1,276 @@
+#pragma once
+
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::read_rlbwt(const std::string& run_heads, const std::vector<pos_t>& run_lengths)
+{
+    if (log) {
+        time = now();
+        std::cout << "reading the RLBWT" << std::flush;
+    }
+
+    // number of (not necessarily maximal) runs in the input
+    pos_t r_in = run_heads.size();
+    uint64_t n_sum = 0;
+
+    #pragma omp parallel for num_threads(p) reduction(+ : n_sum)
+    for (uint64_t i = 0; i < r_in; i++) {
+        n_sum += run_lengths[i];
+    }
+
+    n = n_sum;
+    idx.n = n;
+    prepare_phase_2();
+    p_ = std::max<pos_t>(1, std::min<pos_t>(p, r_in));
+
+    // [0..p'], thread i_p processes the input runs in [s_p[i_p]..s_p[i_p+1]-1]
+    std::vector<pos_t> s_p(p_ + 1);
+
+    for (uint16_t i = 0; i < p_; i++) {
+        s_p[i] = i * (r_in / p_);
+    }
+
+    s_p[p_] = r_in;
+
+    n_p.resize(p_ + 1, 0);
+    r_p.resize(p_ + 1, 0);
+    RLBWT.resize(p_, interleaved_vectors<uint32_t, uint32_t>({ 1, 4 }));
+    C.resize(p_, std::vector<pos_t>(256, 0));
+
+    #pragma omp parallel num_threads(p_)
+    {
+        // Index in [0..p'-1] of the current thread.
+        uint16_t i_p = omp_get_thread_num();
+
+        // symbol of the current run
+        i_sym_t cur_sym = char_to_uchar(run_heads[s_p[i_p]]);
+        // length of the current run
+        pos_t cur_len = 0;
+        // number of BWT positions in thread i_p's section
+        pos_t len_sum = 0;
+
+        // merge adjacent input runs with equal symbols, s.t. the runs in RLBWT[i_p] are maximal
+        for (pos_t i = s_p[i_p]; i < s_p[i_p + 1]; i++) {
+            i_sym_t sym = char_to_uchar(run_heads[i]);
+
+            if (sym != cur_sym) {
+                add_run(i_p, cur_sym, cur_len);
+                C[i_p][cur_sym] += cur_len;
+                len_sum += cur_len;
+                cur_sym = sym;
+                cur_len = 0;
+            }
+
+            cur_len += run_lengths[i];
+        }
+
+        add_run(i_p, cur_sym, cur_len);
+        C[i_p][cur_sym] += cur_len;
+        len_sum += cur_len;
+
+        n_p[i_p + 1] = len_sum;
+        r_p[i_p] = RLBWT[i_p].size();
+        RLBWT[i_p].shrink_to_fit();
+    }
+
+    for (uint16_t i = 1; i <= p_; i++) {
+        n_p[i] += n_p[i - 1];
+    }
+
+    merge_rlbwt_sections();
+
+    // The number of distinct characters in L (including the terminator).
+    idx.sigma = 0;
+
+    for (uint16_t c = 0; c < 256; c++) {
+        for (uint16_t i_p = 0; i_p < p_; i_p++) {
+            if (C[i_p][c] != 0) {
+                idx.sigma++;
+                break;
+            }
+        }
+    }
+
+    process_c();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_build_rlbwt=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_iphim1_sas_lf()
+{
+    if (log) {
+        time = now();
+        std::cout << "building I_Phi^{-1} and SA_s by traversing M_LF" << std::flush;
+    }
+
+    /* [0..r'], K[x] = index of the BWT run starting at the x-th input interval of M_LF, or r, if no BWT run starts there;
+       K[r'] = 0, because the 0-th BWT run succeeds the last one in I_Phi^{-1} */
+    std::vector<pos_t> K;
+    no_init_resize(K, r_ + 1);
+    K[r_] = 0;
+
+    // [0..p], k_p[i_p] = number of BWT runs starting in the input intervals of M_LF before thread i_p's section
+    std::vector<pos_t> k_p(p + 1, 0);
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t x_b = i_p * (r_ / p);
+        pos_t x_e = i_p == p - 1 ? r_ : (i_p + 1) * (r_ / p);
+        pos_t num_runs = 0;
+
+        for (pos_t x = x_b; x < x_e; x++) {
+            if (x == 0 || idx.L_(x - 1) != idx.L_(x)) {
+                num_runs++;
+            }
+        }
+
+        k_p[i_p + 1] = num_runs;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (uint16_t i = 1; i <= p; i++) {
+                k_p[i] += k_p[i - 1];
+            }
+        }
+
+        pos_t k = k_p[i_p];
+
+        for (pos_t x = x_b; x < x_e; x++) {
+            if (x == 0 || idx.L_(x - 1) != idx.L_(x)) {
+                K[x] = k;
+                k++;
+            } else {
+                K[x] = r;
+            }
+        }
+    }
+
+    /* The LF-cycle through [0..n-1] visits the positions in descending order of their suffix array values, hence if we
+       traverse it starting at position 0, where SA[0] = n-1, then the t-th visited position i satisfies SA[i] = n-1-t.
+       To parallelize the traversal, we split the cycle at the starting positions of the input intervals
+       x_s = s * step, s in [0..num_segs-1], of M_LF into num_segs segments. Each segment is traversed independently,
+       where we store the number t of steps from the segment start instead of the suffix array value; once we know the
+       lengths of all segments, we know the suffix array value base[s] at the start of each segment s and can fix the
+       values, since SA[i] = base[s]-t. */
+    pos_t num_segs = p == 1 ? 1 : std::min<pos_t>(r_, 64 * p);
+    pos_t step = r_ / num_segs;
+
+    auto is_seg_start = [&](pos_t i, pos_t x) {
+        return i == idx._M_LF.p(x) && x % step == 0 && x / step < num_segs;
+    };
+
+    // [0..num_segs-1], len[s] = number of positions visited in the s-th segment
+    std::vector<pos_t> len(num_segs);
+    // [0..num_segs-1], next[s] = index of the segment succeeding the s-th segment in the LF-cycle
+    std::vector<pos_t> next(num_segs);
+    // [0..r-1], seg_1[k] (seg_2[k]) = index of the segment I_Phi^{-1}[k].first (I_Phi^{-1}[k].second) has been found in
+    std::vector<uint32_t> seg_1, seg_2;
+    no_init_resize(seg_1, r);
+    no_init_resize(seg_2, r);
+    no_init_resize(I_Phi_m1, r);
+
+    #pragma omp parallel for num_threads(p) schedule(dynamic)
+    for (uint64_t s = 0; s < num_segs; s++) {
+        // index of the input interval of M_LF containing i
+        pos_t x = s * step;
+        // the current position in the BWT
+        pos_t i = idx._M_LF.p(x);
+        // number of steps from the start of the segment
+        pos_t t = 0;
+
+        do {
+            // i is the starting position of the K[x]-th BWT run
+            if (i == idx._M_LF.p(x) && K[x] != r) {
+                I_Phi_m1[K[x]].second = t;
+                seg_2[K[x]] = s;
+            }
+
+            // i is the last position of a BWT run that is succeeded by the K[x+1]-th BWT run (cyclically)
+            if (i + 1 == idx._M_LF.p(x + 1) && K[x + 1] != r) {
+                I_Phi_m1[K[x + 1]].first = t;
+                seg_1[K[x + 1]] = s;
+            }
+
+            idx._M_LF.move(i, x);
+            t++;
+        } while (!is_seg_start(i, x));
+
+        len[s] = t;
+        next[s] = x / step;
+    }
+
+    K.clear();
+    K.shrink_to_fit();
+
+    // [0..num_segs-1], base[s] = suffix array value at the start of the s-th segment
+    std::vector<pos_t> base(num_segs);
+    base[0] = n - 1;
+
+    for (pos_t s = 0, j = 1; j < num_segs; j++) {
+        base[next[s]] = base[s] - len[s];
+        s = next[s];
+    }
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t k = 0; k < r; k++) {
+        I_Phi_m1[k].first = base[seg_1[k]] - I_Phi_m1[k].first;
+        I_Phi_m1[k].second = base[seg_2[k]] - I_Phi_m1[k].second;
+    }
+
+    seg_1.clear();
+    seg_1.shrink_to_fit();
+
+    seg_2.clear();
+    seg_2.shrink_to_fit();
+
+    // build SA_s, where SA_s[x] = SA[M_LF.p(x)] = I_Phi^{-1}[k].second, if the k-th BWT run starts at M_LF.p(x), and n else
+    if constexpr (has_m_phi_m1) {
+        no_init_resize(SA_s, r_);
+    } else {
+        idx._SA_s.resize_no_init(r_);
+    }
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+        pos_t x_b = i_p * (r_ / p);
+        pos_t x_e = i_p == p - 1 ? r_ : (i_p + 1) * (r_ / p);
+        pos_t k = k_p[i_p];
+
+        for (pos_t x = x_b; x < x_e; x++) {
+            pos_t sa_s = n;
+
+            if (x == 0 || idx.L_(x - 1) != idx.L_(x)) {
+                sa_s = I_Phi_m1[k].second;
+                k++;
+            }
+
+            if constexpr (has_m_phi_m1) {
+                SA_s[x] = sa_s;
+            } else {
+                idx._SA_s.template set<0, pos_t>(x, sa_s);
+            }
+        }
+    }
+
+    if constexpr (!has_m_phi_m1) {
+        I_Phi_m1.clear();
+        I_Phi_m1.shrink_to_fit();
+    }
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_build_iphi=" << time_diff_ns(time, now());
+        time = log_runtime(time);
+    }
+}
\ No newline at end of file
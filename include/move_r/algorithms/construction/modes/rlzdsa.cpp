@@ -4,8 +4,9 @@
 #include <move_r/move_r.hpp>
 
 template <move_r_support support, typename sym_t, typename pos_t>
-template <bool bigbwt, typename sad_t, typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_freq_sad()
+template <typename pck_t>
+template <bool sa_file, typename sad_t, typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_freq_sad()
 {
     if (log) {
         time = now();
@@ -37,8 +38,11 @@ void move_r<support, sym_t, pos_t>::construction::build_freq_sad()
         }
     }
 
-    I_Phi_m1.clear();
-    I_Phi_m1.shrink_to_fit();
+    // for support = _locate_hybrid, I_Phi^{-1} is still needed to build M_Phi^{-1}
+    if constexpr (!has_m_phi_m1) {
+        I_Phi_m1.clear();
+        I_Phi_m1.shrink_to_fit();
+    }
 
     if (log) {
         time = log_runtime(time);
@@ -46,8 +50,9 @@ void move_r<support, sym_t, pos_t>::construction::build_freq_sad()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-template <bool bigbwt, typename sad_t, typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_r()
+template <typename pck_t>
+template <bool sa_file, typename sad_t, typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_r()
 {
     if (log) {
         std::cout << "choosing segments for R" << std::flush;
@@ -55,40 +60,64 @@ void move_r<support, sym_t, pos_t>::construction::build_r()
 
     sad_freq_t<sad_t>& SAd_freq = get_SAd_freq<sad_t>();
     idx._R = interleaved_vectors<uint64_t, pos_t>({ (uint8_t)std::ceil(std::log2(2 * n + 1) / (double)8) });
-    std::mt19937 mt(std::random_device {}());
     num_cand_segs = 5 * std::pow(n / (float) r, 0.45);
     pos_t num_cand_segs_thr = num_cand_segs / p + 1; // number of considered candidate segments per thread
     std::vector<gtl::flat_hash_set<sad_t, std::identity>> PV_thr(p);
-    std::vector<std::uniform_int_distribution<pos_t>*> pos_distrib;
+    std::vector<std::uniform_int_distribution<pos_t>> pos_distrib;
+    std::vector<std::mt19937_64> mt_thr; // [0..p-1] random number generators of each thread
 
     for (uint16_t i_p = 0; i_p < p; i_p++) {
-        pos_distrib.emplace_back(new std::uniform_int_distribution<pos_t>(
+        pos_distrib.emplace_back(
             n_p[i_p],
-            std::max<int64_t>(n_p[i_p], int64_t { n_p[i_p + 1] } - seg_size)));
-        if constexpr (bigbwt)
+            std::max<int64_t>(n_p[i_p], int64_t { n_p[i_p + 1] } - seg_size));
+        mt_thr.emplace_back(seed + 0x9E3779B97F4A7C15 * (uint64_t { i_p } + 1));
+        if constexpr (sa_file)
             SA_file_bufs[i_p].buffersize(8 * seg_size);
     }
 
+    struct candidate {
+        pos_t beg;
+        pos_t end;
+        float score;
+        uint16_t i_p; // index of the thread that sampled the candidate (and whose SA file buffer is used to read it)
+    }; // candidate segment
+
+    // returns the score of the segment SA^d[beg..end) against the values that are not yet covered by R
+    auto score_segment = [&](uint16_t i_p, pos_t beg, pos_t end) {
+        float score = 0;
+
+        for (pos_t i = beg; i < end; i++) {
+            sad_t val = SAd<sa_file, sa_sint_t>(i_p, i);
+            pos_t freq = (*SAd_freq.find(val)).second;
+
+            if (freq != 0 && PV_thr[i_p].emplace(val).second) {
+                score += std::sqrt(freq);
+            }
+        }
+
+        PV_thr[i_p].clear();
+        return score / (end - beg);
+    };
+
+    std::vector<std::vector<candidate>> cands_thr(p); // [0..p-1] candidate segments sampled by each thread in the current round
+    std::vector<candidate> cands; // candidate segments of all threads in the current round
+    std::vector<segment> segs_round; // segments selected in the current round
     pos_t size_R_pre_target = 0.95 * size_R_target;
 
+    /* In each round, each thread samples num_cand_segs_thr candidate segments from its section of SA^d and scores them
+     * against the values that are not yet covered by R. Then, up to p pairwise non-overlapping candidates with a score
+     * of at least min_rel_score_round times the best score are selected at once, s.t. the number of rounds decreases
+     * with the number of threads. The frequencies of the values of a selected candidate are reset immediately, and the
+     * following candidates are re-scored before they are selected, s.t. values shared by multiple candidates are only
+     * counted once. Since each thread uses its own random number generator, which is seeded with seed and its thread
+     * index, the choice of R only depends on the input, p and seed. */
     while (size_R < size_R_pre_target) {
-        pos_t beg_best = 0;
-        pos_t end_best = 0;
-        float score_best = 0;
-        ts_it_t it_best = T_s.end();
-        uint16_t ip_best = 0;
-
         #pragma omp parallel num_threads(p)
         {
             uint16_t i_p = omp_get_thread_num();
-
-            pos_t beg_best_thr = 0;
-            pos_t end_best_thr = 0;
-            float score_best_thr = 0;
-            ts_it_t it_best_thr = T_s.end();
+            cands_thr[i_p].clear();
 
             pos_t beg, end;
-            float score;
             ts_it_t it = T_s.end();
 
             for (pos_t seg = 0; seg < num_cand_segs_thr; seg++) {
@@ -96,9 +125,8 @@ void move_r<support, sym_t, pos_t>::construction::build_r()
 
                 do {
                     tries++;
-                    beg = (*pos_distrib[i_p])(mt);
+                    beg = pos_distrib[i_p](mt_thr[i_p]);
                     end = beg + seg_size;
-                    score = 0;
                     it = T_s.lower_bound(segment { beg, 0 });
 
                     if (it != T_s.end()) {
@@ -124,79 +152,104 @@ void move_r<support, sym_t, pos_t>::construction::build_r()
                     }
                 } while (tries < 8 && end == beg);
 
-                for (pos_t i = beg; i < end; i++) {
-                    sad_t val = SAd<bigbwt, sa_sint_t>(i_p, i);
-                    pos_t freq = (*SAd_freq.find(val)).second;
-
-                    if (freq != 0 && PV_thr[i_p].emplace(val).second) {
-                        score += std::sqrt(freq);
-                    }
+                if (end == beg) {
+                    continue;
                 }
 
-                score /= end - beg;
-                PV_thr[i_p].clear();
+                float score = score_segment(i_p, beg, end);
 
-                if (score > score_best_thr) {
-                    beg_best_thr = beg;
-                    end_best_thr = end;
-                    score_best_thr = score;
-                    it_best_thr = it;
+                if (score > 0) {
+                    cands_thr[i_p].emplace_back(candidate { beg, end, score, i_p });
                 }
             }
+        }
 
-            #pragma omp critical
-            {
-                if (score_best_thr > score_best) {
-                    beg_best = beg_best_thr;
-                    end_best = end_best_thr;
-                    score_best = score_best_thr;
-                    it_best = it_best_thr;
-                    ip_best = i_p;
-                }
-            }
+        cands.clear();
+
+        for (uint16_t i_p = 0; i_p < p; i_p++) {
+            cands.insert(cands.end(), cands_thr[i_p].begin(), cands_thr[i_p].end());
         }
 
-        if (score_best == 0) {
+        if (cands.empty()) {
             break;
         }
 
-        bool merged = false;
+        // sort the candidates descendingly by their score; ties are broken by their starting position
+        std::sort(cands.begin(), cands.end(), [](const candidate& c1, const candidate& c2) {
+            return c1.score > c2.score || (c1.score == c2.score && c1.beg < c2.beg);
+        });
 
-        if (it_best != T_s.end() && end_best == (*it_best).beg) {
-            merged = true;
+        segs_round.clear();
+        pos_t size_round = 0;
+        float min_score = min_rel_score_round * cands.front().score;
 
-            if (it_best != T_s.begin()) {
-                auto it_prev = it_best;
-                --it_prev;
+        for (const candidate& c : cands) {
+            if (segs_round.size() == p || c.score < min_score || size_R + size_round >= size_R_pre_target) {
+                break;
+            }
 
-                if ((*it_prev).end == beg_best) {
-                    (*it_prev).end = (*it_best).end;
-                    T_s.erase(it_best);
-                } else {
-                    (*it_best).beg = beg_best;
+            bool overlaps = false;
+
+            for (const segment& s : segs_round) {
+                if (c.beg < s.end && s.beg < c.end) {
+                    overlaps = true;
+                    break;
                 }
-            } else {
-                (*it_best).beg = beg_best;
             }
-        } else if (!T_s.empty() && it_best != T_s.begin()) {
-            auto it_prev = it_best;
-            --it_prev;
 
-            if ((*it_prev).end == beg_best) {
-                (*it_prev).end = end_best;
-                merged = true;
+            if (overlaps) {
+                continue;
             }
-        }
 
-        if (!merged) {
-            T_s.emplace_hint(it_best, segment { beg_best, end_best });
+            // the score of c is outdated, if values of c have been covered by the candidates selected before
+            if (!segs_round.empty() && score_segment(c.i_p, c.beg, c.end) < min_score) {
+                continue;
+            }
+
+            segs_round.emplace_back(segment { c.beg, c.end });
+            size_round += c.end - c.beg;
+
+            for (pos_t i = c.beg; i < c.end; i++) {
+                SAd_freq.find(SAd<sa_file, sa_sint_t>(c.i_p, i))->second = 0;
+            }
         }
 
-        for (pos_t i = beg_best; i < end_best; i++) {
-            SAd_freq.find(SAd<bigbwt, sa_sint_t>(ip_best, i))->second = 0;
+        for (const segment& s : segs_round) {
+            ts_it_t it = T_s.lower_bound(segment { s.beg, 0 });
+            bool merged = false;
+
+            if (it != T_s.end() && s.end == (*it).beg) {
+                merged = true;
+
+                if (it != T_s.begin()) {
+                    auto it_prev = it;
+                    --it_prev;
+
+                    if ((*it_prev).end == s.beg) {
+                        (*it_prev).end = (*it).end;
+                        T_s.erase(it);
+                    } else {
+                        (*it).beg = s.beg;
+                    }
+                } else {
+                    (*it).beg = s.beg;
+                }
+            } else if (!T_s.empty() && it != T_s.begin()) {
+                auto it_prev = it;
+                --it_prev;
+
+                if ((*it_prev).end == s.beg) {
+                    (*it_prev).end = s.end;
+                    merged = true;
+                }
+            }
+
+            if (!merged) {
+                T_s.emplace_hint(it, s);
+            }
         }
 
-        size_R += end_best - beg_best;
+        size_R += size_round;
     }
 
     SAd_freq.clear();
@@ -279,7 +332,7 @@ void move_r<support, sym_t, pos_t>::construction::build_r()
     for (auto seg : T_s) {
         #pragma omp parallel for num_threads(p)
         for (uint64_t j = seg.beg; j < seg.end; j++) {
-            idx._R.template set<0, uint64_t>(i + (j - seg.beg), SAd<bigbwt, sa_sint_t>(omp_get_thread_num(), j));
+            idx._R.template set<0, uint64_t>(i + (j - seg.beg), SAd<sa_file, sa_sint_t>(omp_get_thread_num(), j));
         }
 
         i += seg.end - seg.beg;
@@ -306,7 +359,8 @@ void move_r<support, sym_t, pos_t>::construction::build_r()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_r()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_r()
 {
     if (log) {
         std::cout << "storing R to disk" << std::flush;
@@ -324,8 +378,9 @@ void move_r<support, sym_t, pos_t>::construction::store_r()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
 template <typename sad_t, typename irr_pos_t>
-void move_r<support, sym_t, pos_t>::construction::build_idx_rev_r()
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_idx_rev_r()
 {
     if (log) {
         std::cout << "building move-r of rev(R):" << std::endl
@@ -348,8 +403,9 @@ void move_r<support, sym_t, pos_t>::construction::build_idx_rev_r()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-template <bool bigbwt, bool space, typename sad_t, typename irr_pos_t, typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
+template <typename pck_t>
+template <bool sa_file, bool space, typename sad_t, typename irr_pos_t, typename sa_sint_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_rlzdsa_factorization()
 {
     if (log) {
         std::cout << "computing rlzdsa factorization" << std::flush;
@@ -398,11 +454,11 @@ void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
 
         if constexpr (space) {
             PT_file_bufs[i_p].push_back(1);
-            LP_file_bufs[i_p].push_back(SA<bigbwt, sa_sint_t>(i_p, b));
+            LP_file_bufs[i_p].push_back(SA<sa_file, sa_sint_t>(i_p, b));
         } else {
             _PT[i_p].resize(pt_size);
             _PT[i_p][0] = 1;
-            _LP[i_p].emplace_back(SA<bigbwt, sa_sint_t>(i_p, b));
+            _LP[i_p].emplace_back(SA<sa_file, sa_sint_t>(i_p, b));
         }
 
         auto query = idx_revR.query();
@@ -411,17 +467,17 @@ void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
             query.reset();
             pos_t max_query_len = std::min<pos_t>(e - i, 65535);
 
-            while (query.prepend(SAd<bigbwt, sa_sint_t>(i_p, i + query.length())) &&
+            while (query.prepend(SAd_R<sa_file, sa_sint_t>(i_p, i + query.length())) &&
                    query.length() < max_query_len &&
                    (query.length() <= 1 || query.num_occ() > 1));
 
             if (query.length() <= 1) {
                 if constexpr (space) {
                     PT_file_bufs[i_p].push_back(1);
-                    LP_file_bufs[i_p].push_back(SA<bigbwt, sa_sint_t>(i_p, i));
+                    LP_file_bufs[i_p].push_back(SA<sa_file, sa_sint_t>(i_p, i));
                 } else {
                     _PT[i_p][j] = 1;
-                    _LP[i_p].emplace_back(SA<bigbwt, sa_sint_t>(i_p, i));
+                    _LP[i_p].emplace_back(SA<sa_file, sa_sint_t>(i_p, i));
                 }
 
                 i++;
@@ -433,7 +489,7 @@ void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
                     max_query_len = std::min<pos_t>(max_query_len, size_R - occ);
 
                     while (len < max_query_len &&
-                           idx._R[occ + len] == SAd<bigbwt, sa_sint_t>(i_p, i + len))
+                           idx._R[occ + len] == SAd_R<sa_file, sa_sint_t>(i_p, i + len))
                     {
                         len++;
                     }
@@ -564,37 +620,15 @@ void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
         }
     }
 
-    if (idx.z_c == 0) {
-        sdsl::sd_vector_builder SCP_S_b(n + 1, 1);
-        SCP_S_b.set(n);
-        idx._SCP_S = sd_array<pos_t>(sdsl::sd_vector<>(SCP_S_b));
-    } else {
-        pos_t n_s = std::max<pos_t>(1, idx.z_c / sr_scp);
-        sdsl::sd_vector_builder SCP_S_b(n + 1, n_s + 1);
-        pos_t i_cp = 0;
-        pos_t i_p = idx._PT.select_0(1);
-        pos_t s_cp = i_p;
-
-        for (pos_t i = 0; i < n_s - 1; i++) {
-            SCP_S_b.set(s_cp);
-
-            for (pos_t j = 0; j < sr_scp; j++) {
-                pos_t i_np = idx._PT.select_0(i_cp + 2);
-                s_cp += idx._CPL[i_cp] + (i_np - i_p - 1);
-                i_p = i_np;
-                i_cp++;
-            }
-        }
+    idx.build_scp_s();
 
-        SCP_S_b.set(s_cp);
-        SCP_S_b.set(n);
-        idx._SCP_S = sd_array<pos_t>(sdsl::sd_vector<>(SCP_S_b));
-    }
-
-    if constexpr (bigbwt) {
+    if constexpr (sa_file) {
         SA_file_bufs.clear();
         SA_file_bufs.shrink_to_fit();
-        std::filesystem::remove(prefix_tmp_files + ".sa");
+
+        // the suffix array file is part of the checkpoint
+        if (checkpoint_dir.empty())
+            std::filesystem::remove(path_sa_file);
     }
 
     if (log) {
@@ -606,7 +640,8 @@ void move_r<support, sym_t, pos_t>::construction::build_rlzdsa_factorization()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_r()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_r()
 {
     if (log) {
         std::cout << "reading R from disk" << std::flush;
@@ -620,4 +655,86 @@ void move_r<support, sym_t, pos_t>::construction::load_r()
     if (log) {
         time = log_runtime(time);
     }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+template <typename sad_t, typename irr_pos_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_reference()
+{
+    if (log) {
+        time = now();
+        std::cout << std::endl;
+        std::cout << "building rlzdsa:" << std::endl;
+        std::cout << "reading R and the move-r index of rev(R) from " << path_reference << std::flush;
+    }
+
+    n_u64 = n;
+
+    for (uint16_t i = 0; i < p; i++) {
+        n_p.emplace_back(i * (n / p));
+    }
+
+    n_p.emplace_back(n);
+
+    if constexpr (!has_m_phi_m1) {
+        I_Phi_m1.clear();
+        I_Phi_m1.shrink_to_fit();
+    }
+
+    std::ifstream ref_file(path_reference);
+
+    n_R = std::get<0>(read_reference_header(ref_file, path_reference));
+    idx._R.load(ref_file);
+    get_idx_revR<sad_t, irr_pos_t>().load(ref_file);
+
+    if (ref_file.fail()) {
+        throw std::runtime_error("the reference file " + path_reference + " is truncated");
+    }
+
+    ref_file.close();
+
+    size_R = idx._R.size();
+    idx.n_R = n_R;
+
+    if (!embed_reference) {
+        idx.path_R = std::filesystem::absolute(path_reference).string();
+    }
+
+    if (log) {
+        time = log_runtime(time);
+        std::cout << "n_R: " << n_R << ", |R|: " << size_R << std::endl;
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::build_scp_s()
+    requires(has_rlzdsa)
+{
+    if (z_c == 0) {
+        sdsl::sd_vector_builder SCP_S_b(n + 1, 1);
+        SCP_S_b.set(n);
+        _SCP_S = sd_array<pos_t>(sdsl::sd_vector<>(SCP_S_b));
+    } else {
+        pos_t n_s = std::max<pos_t>(1, z_c / sr_scp);
+        sdsl::sd_vector_builder SCP_S_b(n + 1, n_s + 1);
+        pos_t i_cp = 0;
+        pos_t i_p = _PT.select_0(1);
+        pos_t s_cp = i_p;
+
+        for (pos_t i = 0; i < n_s - 1; i++) {
+            SCP_S_b.set(s_cp);
+
+            for (pos_t j = 0; j < sr_scp; j++) {
+                pos_t i_np = _PT.select_0(i_cp + 2);
+                s_cp += _CPL[i_cp] + (i_np - i_p - 1);
+                i_p = i_np;
+                i_cp++;
+            }
+        }
+
+        SCP_S_b.set(s_cp);
+        SCP_S_b.set(n);
+        _SCP_S = sd_array<pos_t>(sdsl::sd_vector<>(SCP_S_b));
+    }
 }
\ No newline at end of file
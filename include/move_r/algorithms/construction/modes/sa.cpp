@@ -7,7 +7,8 @@
 #include <move_r/move_r.hpp>
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::read_t_from_file(std::ifstream& T_ifile)
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::read_t_from_file(std::ifstream& T_ifile)
 {
     time = now();
     if (log) std::cout << "reading T" << std::flush;
@@ -24,8 +25,55 @@ void move_r<support, sym_t, pos_t>::construction::read_t_from_file(std::ifstream
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::mmap_t_file(const std::filesystem::path& path_t_file)
+{
+    time = now();
+    if (log) std::cout << "memory-mapping T" << std::flush;
+
+    int fd = ::open(path_t_file.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        throw std::runtime_error("could not open " + path_t_file.string());
+    }
+
+    n = std::filesystem::file_size(path_t_file) + 1;
+    idx.n = n;
+    uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t size_mmap = ((n + page_size - 1) / page_size) * page_size;
+
+    /* First, reserve zero-filled anonymous memory for T[0..n-1], then map the file over T[0..n-2]; like this,
+       the terminator T[n-1] = 0 is either in the zero-filled remainder of the last page of the file or in the
+       anonymous memory, hence T does not have to be written to, unless it has to be remapped. Since the mapping
+       is private, the pages are only copied if they are written to. */
+    char* data = (char*)mmap(NULL, size_mmap, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (data != MAP_FAILED) {
+        T_mmap.data = data;
+        T_mmap.size = size_mmap;
+    }
+
+    // if mapping the file fails, the anonymous memory is unmapped by T_mmap
+    if (data == MAP_FAILED || (n > 1 && mmap(data, n - 1, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+        ::close(fd);
+        throw std::runtime_error("could not memory-map " + path_t_file.string());
+    }
+
+    ::close(fd);
+    if (log) time = log_runtime(time);
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::unmap_t_file()
+{
+    T_mmap.unmap();
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
 template <typename sa_sint_t>
-void move_r<support, sym_t, pos_t>::construction::build_sa()
+void move_r<support, sym_t, pos_t>::construction<pck_t>::build_sa()
 {
     std::vector<sa_sint_t>& SA = get_sa<sa_sint_t>(); // [0..n-1] The suffix array
 
@@ -42,21 +90,7 @@ void move_r<support, sym_t, pos_t>::construction::build_sa()
             libsais64_omp(&T<uint8_t>(0), SA.data(), n, fs, NULL, p);
         }
     } else {
-        if (idx.symbols_remapped) {
-            if (log) {
-                time = now();
-                std::cout << "mapping T to its effective alphabet" << std::flush;
-            }
-
-            #pragma omp parallel for num_threads(p)
-            for (uint64_t i = 0; i < n - 1; i++) {
-                T<i_sym_t>(i) = (*idx._map_int.find(T<sym_t>(i))).second;
-            }
-
-            if (log) time = log_runtime(time);
-            if (mode == _suffix_array_space)
-                store_mapintext();
-        }
+        map_t();
 
         if (log) std::cout << "building SA" << std::flush;
 
@@ -109,7 +143,29 @@ void move_r<support, sym_t, pos_t>::construction::build_sa()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::store_mapintext()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::map_t()
+{
+    if (idx.symbols_remapped) {
+        if (log) {
+            time = now();
+            std::cout << "mapping T to its effective alphabet" << std::flush;
+        }
+
+        #pragma omp parallel for num_threads(p)
+        for (uint64_t i = 0; i < n - 1; i++) {
+            T<i_sym_t>(i) = (*idx._map_int.find(T<sym_t>(i))).second;
+        }
+
+        if (log) time = log_runtime(time);
+        if (mode == _suffix_array_space)
+            store_mapintext();
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::store_mapintext()
 {
     if (log) {
         time = now();
@@ -134,7 +190,8 @@ void move_r<support, sym_t, pos_t>::construction::store_mapintext()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::load_mapintext()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::load_mapintext()
 {
     if (log) {
         time = now();
@@ -160,7 +217,8 @@ void move_r<support, sym_t, pos_t>::construction::load_mapintext()
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
-void move_r<support, sym_t, pos_t>::construction::unmap_t()
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::unmap_t()
 {
     if constexpr (str_input) {
         #pragma omp parallel for num_threads(p)
@@ -175,4 +233,146 @@ void move_r<support, sym_t, pos_t>::construction::unmap_t()
             T<sym_t>(i) = idx._map_ext[T<i_sym_t>(i)];
         }
     }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+pos_t move_r<support, sym_t, pos_t>::construction<pck_t>::estimate_r()
+{
+    // length of the sampled prefix of T (without the terminator)
+    uint64_t len = std::min<uint64_t>(n - 1, 1 << 20);
+
+    if (len == 0)
+        return 1;
+
+    // [0..len-1] the sampled prefix of T
+    std::vector<i_sym_t> T_smpl;
+    no_init_resize(T_smpl, len);
+
+    for (uint64_t i = 0; i < len; i++) {
+        T_smpl[i] = T<i_sym_t>(i);
+    }
+
+    // [0..sigma'-1] the distinct symbols in the prefix
+    std::vector<i_sym_t> syms(T_smpl);
+    ips4o::sort(syms.begin(), syms.end());
+    syms.erase(std::unique(syms.begin(), syms.end()), syms.end());
+
+    // [0..len] the prefix mapped to its effective alphabet [1..sigma'], terminated by 0
+    std::vector<int32_t> T_int;
+    no_init_resize(T_int, len + 1);
+
+    for (uint64_t i = 0; i < len; i++) {
+        T_int[i] = 1 + (std::lower_bound(syms.begin(), syms.end(), T_smpl[i]) - syms.begin());
+    }
+
+    T_int[len] = 0;
+    T_smpl.clear();
+    T_smpl.shrink_to_fit();
+
+    std::vector<int32_t> SA_smpl;
+    no_init_resize(SA_smpl, len + 1);
+    libsais_int(T_int.data(), SA_smpl.data(), len + 1, syms.size() + 1, 0);
+
+    // number of runs in the BWT of the prefix
+    uint64_t r_smpl = 1;
+    int32_t prev_sym = SA_smpl[0] == 0 ? 0 : T_int[SA_smpl[0] - 1];
+
+    for (uint64_t i = 1; i <= len; i++) {
+        int32_t cur_sym = SA_smpl[i] == 0 ? 0 : T_int[SA_smpl[i] - 1];
+
+        if (cur_sym != prev_sym) {
+            r_smpl++;
+            prev_sym = cur_sym;
+        }
+    }
+
+    /* r grows at most linearly in the length of the input, and sublinearly for repetitive inputs, so
+       extrapolating linearly from the prefix yields an (usually pessimistic) estimate */
+    return std::min<uint64_t>(n, std::ceil(r_smpl * (n / (double)(len + 1))));
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+template <typename pck_t>
+void move_r<support, sym_t, pos_t>::construction<pck_t>::choose_construction_mode()
+{
+    if (log) {
+        time = now();
+        std::cout << "estimating r to choose the construction mode" << std::flush;
+    }
+
+    uint64_t r_est = estimate_r();
+
+    if (log) {
+        if (mf_idx != NULL)
+            *mf_idx << " time_estimate_r=" << time_diff_ns(time, now()) << " r_est=" << r_est;
+        time = log_runtime(time);
+    }
+
+    // number of bytes per suffix array entry (see construct_from_sa())
+    uint64_t w_sa = std::is_same_v<pos_t, uint64_t> || n > INT_MAX ? 8 : 4;
+    // size of the suffix array (and of the temporary buffers used by libsais)
+    uint64_t size_sa = n * w_sa;
+
+    if constexpr (byte_alphabet) {
+        size_sa += 6 * 256 * w_sa;
+    } else if constexpr (sizeof(i_sym_t) == 4) {
+        if (w_sa == 8) size_sa += n * 8; // T is copied to 64-bit integers
+    } else if constexpr (sizeof(i_sym_t) == 8) {
+        if (w_sa == 4) size_sa += n * 4; // libsais64_long needs a 64-bit suffix array
+    }
+
+    // size of T
+    uint64_t size_t_ = n * sizeof(sym_t);
+    /* size of the data structures of size O(r) that are in memory at the same time as the suffix array (I_LF, M_LF,
+       the RLBWT, I_Phi^{-1} and SA_s); I_LF, I_Phi^{-1} and SA_s store packed positions (see packed_t) */
+    uint64_t size_r = r_est * (5 * sizeof(pck_t) + 4 * sizeof(pos_t) + 5);
+    // size of the data structures of size O(r) that are in memory while SA_s, M_LF, RS_L' and the RLBWT are spilled to disk
+    uint64_t size_r_space = r_est * (2 * sizeof(pck_t) + 3 * sizeof(pos_t) + 5);
+
+    if constexpr (has_rlzdsa) {
+        // R, rev(R), the frequencies of the values in SA^d and the index of rev(R)
+        uint64_t size_rlzdsa = std::min<uint64_t>(n / 3, 5.2 * r_est) * (4 * sizeof(pos_t) + 16);
+        size_r += size_rlzdsa;
+        size_r_space += size_rlzdsa;
+    }
+
+    // estimated peak memory usage of each construction mode
+    uint64_t peak_sa = size_t_ + size_sa + size_r;
+    uint64_t peak_sa_space = size_t_ + size_sa + size_r_space;
+    // T, L and the parse (the suffix array is written to disk)
+    uint64_t peak_pfp = str_input ? (2 * n + n / 4 + size_r_space) : std::numeric_limits<uint64_t>::max();
+
+    if (peak_sa <= max_memory) {
+        mode = _suffix_array;
+    } else if (peak_sa_space <= max_memory) {
+        mode = _suffix_array_space;
+    } else if (peak_pfp <= max_memory) {
+        mode = _pfp;
+    } else {
+        mode = peak_pfp < peak_sa_space ? _pfp : _suffix_array_space;
+        if (log) std::cout << "warning: the estimated peak memory usage of all construction modes exceeds the budget" << std::endl;
+    }
+
+    uint64_t peak = mode == _suffix_array ? peak_sa : (mode == _suffix_array_space ? peak_sa_space : peak_pfp);
+
+    /* per-thread buffers: the per-thread C-arrays (only for byte alphabets), the per-thread sections of the RLBWT
+       and the file buffers for reading the suffix array file and writing the rlzdsa */
+    uint64_t size_thr = (byte_alphabet ? 256 : 0) * sizeof(pos_t) + (1 << 20);
+    uint64_t p_max = peak >= max_memory ? 1 : (max_memory - peak) / size_thr;
+
+    if (p > p_max) {
+        p = std::max<uint64_t>(1, p_max);
+        p_ = std::min<uint16_t>(p_, p);
+        if (log) std::cout << "warning: per-thread buffers exceed the memory budget, setting p to " << std::to_string(p) << std::endl;
+    }
+
+    if (log) {
+        std::cout << "chose construction mode " << (mode == _suffix_array ? "sa" : (mode == _suffix_array_space ? "sa_space" : "pfp"))
+                  << " (estimated peak memory usage: " << format_size(peak) << ", budget: " << format_size(max_memory) << ")" << std::endl;
+
+        if (mf_idx != NULL)
+            *mf_idx << " chosen_mode=" << (mode == _suffix_array ? "sa" : (mode == _suffix_array_space ? "sa_space" : "pfp"))
+                    << " estimated_peak_mem_usage=" << peak << " p_budget=" << p;
+    }
 }
\ No newline at end of file
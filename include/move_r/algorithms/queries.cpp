@@ -4,7 +4,7 @@
 
 template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::setup_phi_m1_move_pair(pos_t& x, pos_t& s, pos_t& s_) const
-    requires(support == _locate_move)
+    requires(has_m_phi_m1)
 {
     // the index of the pair in M_Phi^{-1} creating the output interval with starting position s = SA[M_LF.p[x]]
     pos_t x_s_ = SA_Phi_m1(x);
@@ -27,7 +27,7 @@ template <move_r_support support, typename sym_t, typename pos_t>
 pos_t move_r<support, sym_t, pos_t>::SA(pos_t i) const
     requires(supports_multiple_locate)
 {
-    if constexpr (support == _locate_rlzdsa) {
+    if constexpr (has_rlzdsa) {
         pos_t x_p, x_lp, x_cp, x_r, s_np;
 
         // variable to store SA[i] in
@@ -123,34 +123,35 @@ template <move_r_support support, typename sym_t, typename pos_t>
 pos_t move_r<support, sym_t, pos_t>::query_context::next_occ()
     requires(supports_multiple_locate)
 {
-    if constexpr (support == _locate_rlzdsa) {
-        if (i == b) [[unlikely]] {
-            // compute the suffix array value at b
-            s = idx->SA_s(hat_b_ap_y) - (y + 1);
-            i++;
+    if (idx->use_rlzdsa(e - b + 1)) {
+        if constexpr (has_rlzdsa) {
+            if (i == b) [[unlikely]] {
+                // compute the suffix array value at b
+                s = idx->SA_s(hat_b_ap_y) - (y + 1);
+                i++;
 
-            // check if there is more than one occurrence
-            if (b < e) {
-                idx->init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
+                // check if there is more than one occurrence
+                if (b < e) {
+                    idx->init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
+                }
+            } else {
+                idx->next_rlzdsa(i, s, x_p, x_lp, x_cp, x_r, s_np);
             }
-
-            return s;
-        } else {
-            idx->next_rlzdsa(i, s, x_p, x_lp, x_cp, x_r, s_np);
-            return s;
         }
     } else {
-        if (i == b) [[unlikely]] {
-            // compute the suffix array value at b
-            idx->init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
-            i++;
-            return s;
-        } else {
-            idx->M_Phi_m1().move(s, s_);
-            i++;
-            return s;
+        if constexpr (has_m_phi_m1) {
+            if (i == b) [[unlikely]] {
+                // compute the suffix array value at b
+                idx->init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
+                i++;
+            } else {
+                idx->M_Phi_m1().move(s, s_);
+                i++;
+            }
         }
     }
+
+    return s;
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
@@ -166,38 +167,42 @@ void move_r<support, sym_t, pos_t>::query_context::locate(std::vector<pos_t>& Oc
 {
     Occ.reserve(Occ.size() + num_occ_rem());
 
-    if constexpr (support == _locate_rlzdsa) {
-        if (i == b) [[unlikely]] {
-            // compute the suffix array value at b
-            s = idx->SA_s(hat_b_ap_y) - (y + 1);
-            Occ.emplace_back(s);
-            i++;
+    if (idx->use_rlzdsa(e - b + 1)) {
+        if constexpr (has_rlzdsa) {
+            if (i == b) [[unlikely]] {
+                // compute the suffix array value at b
+                s = idx->SA_s(hat_b_ap_y) - (y + 1);
+                Occ.emplace_back(s);
+                i++;
 
-            // check if there is more than one occurrence
-            if (b < e) [[likely]] {
-                idx->init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
+                // check if there is more than one occurrence
+                if (b < e) [[likely]] {
+                    idx->init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
+                }
             }
-        }
 
-        // compute the remaining occurrences SA(b,e]
-        if (i <= e) [[likely]] {
-            pos_t o = Occ.size();
-            no_init_resize(Occ, o + num_occ_rem());
-            idx->write_rlzdsa_right(i, e, s, x_p, x_lp, x_cp, x_r, s_np, Occ, o);
+            // compute the remaining occurrences SA(b,e]
+            if (i <= e) [[likely]] {
+                pos_t o = Occ.size();
+                no_init_resize(Occ, o + num_occ_rem());
+                idx->write_rlzdsa_right(i, e, s, x_p, x_lp, x_cp, x_r, s_np, Occ, o);
+            }
         }
     } else {
-        // compute the suffix array value at b
-        if (i == b) [[unlikely]] {
-            idx->init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
-            Occ.emplace_back(s);
-            i++;
-        }
+        if constexpr (has_m_phi_m1) {
+            // compute the suffix array value at b
+            if (i == b) [[unlikely]] {
+                idx->init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
+                Occ.emplace_back(s);
+                i++;
+            }
 
-        // compute the remaining occurrences SA(b,e]
-        while (i <= e) {
-            idx->M_Phi_m1().move(s, s_);
-            Occ.emplace_back(s);
-            i++;
+            // compute the remaining occurrences SA(b,e]
+            while (i <= e) {
+                idx->M_Phi_m1().move(s, s_);
+                Occ.emplace_back(s);
+                i++;
+            }
         }
     }
 }
@@ -301,7 +306,16 @@ bool move_r<support, sym_t, pos_t>::backward_search_step(
         return false;
     }
 
-    /* Else, set b <- LF(b) and e <- LF(e). The following two optimizations increase query throughput slightly
+    // Else, set b <- LF(b) and e <- LF(e).
+    lf_interval(b, e, b_, e_);
+
+    return true;
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::lf_interval(pos_t& b, pos_t& e, pos_t& b_, pos_t& e_) const
+{
+    /* Set b <- LF(b) and e <- LF(e). The following two optimizations increase query throughput slightly
         if there are only few occurrences */
     if (b_ == e_) {
         if (b == e) {
@@ -327,8 +341,94 @@ bool move_r<support, sym_t, pos_t>::backward_search_step(
         M_LF().move(b, b_);
         M_LF().move(e, e_);
     }
+}
 
-    return true;
+template <move_r_support support, typename sym_t, typename pos_t>
+std::vector<std::pair<sym_t, typename move_r<support, sym_t, pos_t>::query_context>>
+move_r<support, sym_t, pos_t>::query_context::children() const
+{
+    std::vector<std::pair<sym_t, query_context>> children;
+
+    if (b > e) [[unlikely]] {
+        return children;
+    }
+
+    // [0..|children|-1] the first and last (sub-)run in L'[b_,e_] of each symbol occurring in it, in ascending order of the symbols
+    std::vector<std::tuple<i_sym_t, pos_t, pos_t>> runs;
+
+    if (e_ - b_ < idx->sigma) {
+        // If there are only few (sub-)runs in L'[b_,e_], sort them by their symbols.
+        std::vector<std::pair<i_sym_t, pos_t>> syms;
+        syms.reserve(e_ - b_ + 1);
+
+        for (pos_t x = b_; x <= e_; x++) {
+            syms.emplace_back(idx->L_(x), x);
+        }
+
+        std::sort(syms.begin(), syms.end());
+
+        for (pos_t j = 0; j < syms.size(); j++) {
+            if (j == 0 || syms[j].first != syms[j - 1].first) {
+                runs.emplace_back(syms[j].first, syms[j].second, syms[j].second);
+            } else {
+                std::get<2>(runs.back()) = syms[j].second;
+            }
+        }
+    } else {
+        // Else, find the first and last (sub-)run in L'[b_,e_] of each symbol with RS_L'.
+        const rsl_t& RS_L_ = idx->RS_L_();
+        uint64_t sigma_max = byte_alphabet ? 256 : idx->sigma;
+
+        for (uint64_t v = 0; v < sigma_max; v++) {
+            if (!RS_L_.contains(v)) {
+                continue;
+            }
+
+            pos_t rnk_b = RS_L_.rank(v, b_);
+            pos_t rnk_e = RS_L_.rank(v, e_ + 1);
+
+            if (rnk_b < rnk_e) {
+                runs.emplace_back(v, RS_L_.select(v, rnk_b + 1), RS_L_.select(v, rnk_e));
+            }
+        }
+    }
+
+    children.reserve(runs.size());
+
+    for (auto [sym, x_b, x_e] : runs) {
+        // the terminator cannot be prepended to a pattern
+        if (sym == 0) {
+            continue;
+        }
+
+        // perform the backward search step for sym with the known (sub-)runs \hat{b}'_y = x_b and \hat{e}'_z = x_e
+        query_context child = *this;
+
+        if (x_b != b_) {
+            child.b = idx->M_LF().p(x_b);
+            child.b_ = x_b;
+            child.y = 0;
+            child.hat_b_ap_y = x_b;
+        } else {
+            child.y++;
+        }
+
+        if (x_e != e_) {
+            child.e = idx->M_LF().p(x_e + 1) - 1;
+            child.e_ = x_e;
+            child.z = 0;
+            child.hat_e_ap_z = x_e;
+        } else {
+            child.z++;
+        }
+
+        idx->lf_interval(child.b, child.e, child.b_, child.e_);
+        child.l++;
+        child.i = child.b;
+        children.emplace_back(idx->unmap_symbol(sym), child);
+    }
+
+    return children;
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
@@ -336,7 +436,7 @@ void move_r<support, sym_t, pos_t>::init_phi_m1(
     pos_t& b, pos_t& e,
     pos_t& s, pos_t& s_,
     pos_t& hat_b_ap_y, int64_t& y) const
-    requires(support == _locate_move)
+    requires(has_m_phi_m1)
 {
     setup_phi_m1_move_pair(hat_b_ap_y, s, s_);
     s -= y + 1;
@@ -353,7 +453,7 @@ template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::init_rlzdsa(
     pos_t& i,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     // index in SCP_S of the last sampled copy phrase starting before or at i
     pos_t x_scps = SCP_S().rank_1(i + 1);
@@ -411,12 +511,12 @@ template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::init_rlzdsa(
     pos_t& i, pos_t& s,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     // index of the input interval in M_LF containing i.
     pos_t x = bin_search_max_leq<pos_t>(i, 0, r_ - 1, [this](pos_t x_) { return M_LF().p(x_); });
 
-    while (SA_s(x) == n) {
+    while (!SA_s_sampled(x)) {
         x--;
     }
 
@@ -430,10 +530,10 @@ void move_r<support, sym_t, pos_t>::init_rlzdsa(
             pos_t sad_i = R(x_r);
 
             // set s <- SA[i-1] = SA[i]-SA^d[i]
-            if (sad_i < n) {
-                s += n - sad_i;
+            if (sad_i < n_R) {
+                s += n_R - sad_i;
             } else {
-                s -= sad_i - n;
+                s -= sad_i - n_R;
             }
         }
     } else {
@@ -447,7 +547,7 @@ template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::skip_rlzdsa_right(
     pos_t& i, pos_t& e, pos_t& s,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     while (i < e) {
         // decode all copy-phrases before the next literal phrase
@@ -455,7 +555,7 @@ void move_r<support, sym_t, pos_t>::skip_rlzdsa_right(
             // decode the x_cp-th copy-phrase
             while (i < s_np && i < e) {
                 s += R(x_r);
-                s -= n;
+                s -= n_R;
                 i++;
                 x_r++;
             }
@@ -490,7 +590,7 @@ template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::next_rlzdsa(
     pos_t& i, pos_t& s,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     if (PT(x_p)) {
         // literal phrase
@@ -511,7 +611,7 @@ void move_r<support, sym_t, pos_t>::next_rlzdsa(
     } else {
         // copy-prhase
         s += R(x_r);
-        s -= n;
+        s -= n_R;
         i++;
         x_r++;
 
@@ -537,7 +637,7 @@ void move_r<support, sym_t, pos_t>::write_rlzdsa_right(
     pos_t& i, pos_t& e, pos_t& s,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np,
     std::vector<pos_t>& vec, pos_t o) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     while (true) {
         // decode all copy-phrases before the next literal phrase
@@ -545,7 +645,7 @@ void move_r<support, sym_t, pos_t>::write_rlzdsa_right(
             // decode the x_cp-th copy-phrase
             while (i < s_np) {
                 s += R(x_r);
-                s -= n;
+                s -= n_R;
                 vec[o] = s;
 
                 if (i == e) [[unlikely]] {
@@ -591,7 +691,7 @@ void move_r<support, sym_t, pos_t>::report_rlzdsa_right(
     pos_t& i, pos_t& e, pos_t& s,
     pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np,
     const std::function<void(pos_t, pos_t)>& report) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     while (true) {
         // decode all copy-phrases before the next literal phrase
@@ -599,7 +699,7 @@ void move_r<support, sym_t, pos_t>::report_rlzdsa_right(
             // decode the x_cp-th copy-phrase
             while (i < s_np) {
                 s += R(x_r);
-                s -= n;
+                s -= n_R;
                 report(i, s);
 
                 if (i == e) [[unlikely]] {
@@ -670,34 +770,117 @@ void move_r<support, sym_t, pos_t>::locate(const inp_t& P, std::vector<pos_t>& O
         }
     }
 
-    if constexpr (support == _locate_rlzdsa) {
-        pos_t o = Occ.size();
-        no_init_resize(Occ, o + e - b + 1);
-        pos_t s = SA_s(hat_b_ap_y) - (y + 1);
-        Occ[o] = s;
+    if (use_rlzdsa(e - b + 1)) {
+        if constexpr (has_rlzdsa) {
+            pos_t o = Occ.size();
+            no_init_resize(Occ, o + e - b + 1);
+            pos_t s = SA_s(hat_b_ap_y) - (y + 1);
+            Occ[o] = s;
 
-        if (b < e) {
-            pos_t i = b + 1;
-            pos_t x_p, x_lp, x_cp, x_r, s_np;
+            if (b < e) {
+                pos_t i = b + 1;
+                pos_t x_p, x_lp, x_cp, x_r, s_np;
 
-            init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
-            write_rlzdsa_right(i, e, s, x_p, x_lp, x_cp, x_r, s_np, Occ, o + 1);
+                init_rlzdsa(i, x_p, x_lp, x_cp, x_r, s_np);
+                write_rlzdsa_right(i, e, s, x_p, x_lp, x_cp, x_r, s_np, Occ, o + 1);
+            }
         }
     } else {
-        pos_t s, s_;
-        init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
-        Occ.emplace_back(s);
+        if constexpr (has_m_phi_m1) {
+            pos_t s, s_;
+            init_phi_m1(b, e, s, s_, hat_b_ap_y, y);
+            Occ.emplace_back(s);
 
-        if (b < e) {
-            pos_t i = b + 1;
+            if (b < e) {
+                pos_t i = b + 1;
 
-            while (i <= e) {
-                M_Phi_m1().move(s, s_);
-                Occ.emplace_back(s);
-                i++;
+                while (i <= e) {
+                    M_Phi_m1().move(s, s_);
+                    Occ.emplace_back(s);
+                    i++;
+                }
+            }
+        }
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::calibrate_min_occ_threshold(uint64_t num_samples, uint64_t seed)
+    requires(support == _locate_hybrid)
+{
+    // number of buckets; bucket k stores patterns with [2^k,2^{k+1}) occurrences
+    constexpr uint8_t num_buckets = 17;
+    // maximum length of a sampled pattern
+    constexpr pos_t max_pattern_length = 1024;
+
+    // [0..num_buckets-1] query contexts of the sampled patterns in each bucket
+    std::vector<std::vector<query_context>> patterns(num_buckets);
+    uint64_t num_patterns = 0;
+    uint64_t max_num_attempts = 16 * num_buckets * num_samples;
+
+    std::mt19937_64 mt(seed);
+    std::uniform_int_distribution<pos_t> pos_distrib(0, n - 1);
+
+    /* sample patterns by choosing random positions i in the bwt and repeatedly prepending L[i] to
+       the pattern and setting i <- LF(i), s.t. the pattern always occurs in the input */
+    for (uint64_t attempt = 0; attempt < max_num_attempts && num_patterns < num_buckets * num_samples; attempt++) {
+        pos_t i = pos_distrib(mt);
+        pos_t x = bin_search_max_leq<pos_t>(i, 0, r_ - 1, [this](pos_t x_) { return M_LF().p(x_); });
+        query_context ctx = query();
+
+        // stop at the terminator, because it cannot be part of a pattern
+        while (ctx.length() < max_pattern_length && L_(x) != 0) {
+            if (!ctx.prepend(unmap_symbol(L_(x)))) {
+                break;
+            }
+
+            M_LF().move(i, x);
+            uint8_t k = (uint8_t)std::floor(std::log2(ctx.num_occ()));
+
+            if (k < num_buckets && patterns[k].size() < num_samples) {
+                patterns[k].emplace_back(ctx);
+                num_patterns++;
+            }
+
+            if (ctx.num_occ() == 1) {
+                break;
             }
         }
     }
+
+    // [0..num_buckets-1] time (in ns) needed to locate the patterns in each bucket with M_Phi^{-1} and the rlzdsa
+    std::vector<uint64_t> time_phi(num_buckets, 0);
+    std::vector<uint64_t> time_rlzdsa(num_buckets, 0);
+    std::vector<pos_t> Occ;
+
+    for (uint8_t k = 0; k < num_buckets; k++) {
+        for (bool rlzdsa : { false, true }) {
+            min_occ_rlzdsa = rlzdsa ? 0 : std::numeric_limits<pos_t>::max();
+            auto time = now();
+
+            for (query_context ctx : patterns[k]) {
+                Occ.clear();
+                ctx.locate(Occ);
+            }
+
+            (rlzdsa ? time_rlzdsa : time_phi)[k] = time_diff_ns(time, now());
+        }
+    }
+
+    // choose the smallest power of two, from which on the rlzdsa is not slower than M_Phi^{-1} in any bucket
+    min_occ_rlzdsa = std::numeric_limits<pos_t>::max();
+
+    for (int16_t k = num_buckets - 1; k >= 0; k--) {
+        if (patterns[k].empty()) {
+            continue;
+        }
+
+        if (time_rlzdsa[k] > time_phi[k]) {
+            break;
+        }
+
+        min_occ_rlzdsa = pos_t{1} << k;
+    }
 }
 
 template <move_r_support support, typename sym_t, typename pos_t>
@@ -752,24 +935,153 @@ void move_r<support, sym_t, pos_t>::revert(const std::function<void(pos_t, sym_t
         // start iterating at the right iteration range end position
         pos_t j = j_r;
 
-        // iterate until j = r
-        while (j > r) {
-            // Set i <- LF(i) and j <- j-1.
-            M_LF().move(i, x);
-            j--;
+        if (k_lf == 1) {
+            // iterate until j = r
+            while (j > r) {
+                // Set i <- LF(i) and j <- j-1.
+                M_LF().move(i, x);
+                j--;
+            }
+
+            // Report T[r] = T[j] = L[i] = L'[x]
+            report(j, unmap_symbol(L_(x)));
+
+            // report T[l,r-1] from right to left
+            while (j > j_l) {
+                // Set i <- LF(i) and j <- j-1.
+                M_LF().move(i, x);
+                j--;
+                // Report T[j] = L[i] = L'[x].
+                report(j, unmap_symbol(L_(x)));
+            }
+        } else {
+            // index of the input interval in M_LF^k containing i.
+            x = sr_ip == p_r - 1 ? 0 : bin_search_max_leq<pos_t>(i, 0, _M_LF_k.num_intervals() - 1, [this](pos_t x_) { return _M_LF_k.p(x_); });
+
+            // iterate until j < r + k
+            while (j >= r + k_lf) {
+                // Set i <- LF^k(i) and j <- j-k.
+                _M_LF_k.move(i, x);
+                j -= k_lf;
+            }
+
+            // report T[l,r] from right to left, k characters per move query
+            while (true) {
+                // Report T[j-t] = L[LF^t(i)] = L_k[x*k+t] for each t in [0..k-1] with l <= j-t <= r.
+                for (uint8_t t = 0; t < k_lf && t <= j - j_l; t++) {
+                    if (j - t <= r) {
+                        report(j - t, unmap_symbol(_L_k[x * (uint64_t)k_lf + t]));
+                    }
+                }
+
+                if (j < j_l + k_lf) {
+                    break;
+                }
+
+                // Set i <- LF^k(i) and j <- j-k.
+                _M_LF_k.move(i, x);
+                j -= k_lf;
+            }
         }
+    }
+}
 
-        // Report T[r] = T[j] = L[i] = L'[x]
-        report(j, unmap_symbol(L_(x)));
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::revert_forward(const std::function<void(pos_t, sym_t)>& report, retrieve_params params) const
+{
+    if (!has_m_fl()) {
+        revert(report, params);
+        return;
+    }
 
-        // report T[l,r-1] from right to left
-        while (j > j_l) {
-            // Set i <- LF(i) and j <- j-1.
-            M_LF().move(i, x);
-            j--;
-            // Report T[j] = L[i] = L'[x].
-            report(j, unmap_symbol(L_(x)));
+    adjust_retrieve_params(params, n - 2);
+
+    pos_t l = params.l;
+    pos_t r = params.r;
+
+    // leftmost section to revert
+    uint16_t s_l;
+    // rightmost section to revert
+    uint16_t s_r;
+
+    if (p_r == 1) {
+        s_l = 0;
+        s_r = 0;
+    } else {
+        s_l = bin_search_min_gt<pos_t>(l, 0, p_r - 1, [this](pos_t x) { return _D_e[x].second; });
+        s_r = bin_search_min_geq<pos_t>(r, 0, p_r - 1, [this](pos_t x) { return _D_e[x].second; });
+    }
+
+    uint16_t p = std::max(
+        (uint16_t)1, // use at least one thread
+        std::min({
+            (uint16_t)(s_r - s_l + 1), // use at most s_r-s_l+1 threads
+            (uint16_t)omp_get_max_threads(), // use at most all threads
+            params.num_threads // use at most the specified number of threads
+        }));
+
+    #pragma omp parallel num_threads(p)
+    {
+        // Index in [0..p-1] of the current thread.
+        uint16_t i_p = omp_get_thread_num();
+
+        // leftmost section for thread i_p to revert
+        uint16_t sl_ip = s_l + (i_p * (s_r - s_l + 1)) / p;
+        // rightmost section for thread i_p to revert
+        uint16_t sr_ip = i_p == p - 1 ? s_r : s_l + ((i_p + 1) * (s_r - s_l + 1)) / p - 1;
+
+        // Iteration range start position of thread i_p.
+        pos_t j_l = std::max(l, sl_ip == 0 ? 0 : (_D_e[sl_ip - 1].second + 1) % n);
+        // Iteration range end position of thread i_p.
+        pos_t j_r = std::min(r, sr_ip == p_r - 1 ? n - 2 : _D_e[sr_ip].second);
+
+        // The position in the bwt of the first suffix of the section.
+        pos_t i = sl_ip == 0 ? 0 : M_LF().p(_D_e[sl_ip - 1].first);
+        // The current position in T, i.e., j = SA[i].
+        pos_t j = sl_ip == 0 ? n - 1 : (_D_e[sl_ip - 1].second + 1) % n;
+
+        // index of the input interval in M_FL containing i.
+        pos_t x = bin_search_max_leq<pos_t>(i, 0, _M_FL.num_intervals() - 1, [this](pos_t x_) { return _M_FL.p(x_); });
+
+        // SA[0] = n-1 is the position of the terminator, so set i <- FL(i) and j <- 0.
+        if (j == n - 1) {
+            _M_FL.move(i, x);
+            j = 0;
         }
+
+        // iterate until j = l
+        while (j < j_l) {
+            // Set i <- FL(i) and j <- j+1.
+            _M_FL.move(i, x);
+            j++;
+        }
+
+        // Report T[j] = F[i] = F'[x]
+        report(j, unmap_symbol(_M_FL.L_(x)));
+
+        // report T[j+1,j_r] from left to right
+        while (j < j_r) {
+            // Set i <- FL(i) and j <- j+1.
+            _M_FL.move(i, x);
+            j++;
+            // Report T[j] = F[i] = F'[x].
+            report(j, unmap_symbol(_M_FL.L_(x)));
+        }
+    }
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::extract(pos_t i, pos_t m, const std::function<void(pos_t, sym_t)>& report) const
+{
+    // index of the input interval in M_FL containing i.
+    pos_t x = bin_search_max_leq<pos_t>(i, 0, _M_FL.num_intervals() - 1, [this](pos_t x_) { return _M_FL.p(x_); });
+
+    // SA[0] = n-1 is the position of the terminator, so the end of the input has been reached at i = 0
+    for (pos_t t = 0; t < m && i != 0; t++) {
+        // Report T[SA[i]+t] = F[FL^t(i)] = F'[x].
+        report(t, unmap_symbol(_M_FL.L_(x)));
+        // Set i <- FL(i).
+        _M_FL.move(i, x);
     }
 }
 
@@ -902,7 +1214,7 @@ void move_r<support, sym_t, pos_t>::SA(std::vector<pos_t>& SA_range, retrieve_pa
 
 template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::SA(const std::function<void(pos_t, pos_t)>& report, retrieve_params params) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     adjust_retrieve_params(params, n - 1);
 
@@ -942,7 +1254,7 @@ void move_r<support, sym_t, pos_t>::SA(const std::function<void(pos_t, pos_t)>&
 
 template <move_r_support support, typename sym_t, typename pos_t>
 void move_r<support, sym_t, pos_t>::SA(std::vector<pos_t>& SA_range, retrieve_params params) const
-    requires(support == _locate_rlzdsa)
+    requires(has_rlzdsa)
 {
     adjust_retrieve_params(params, n - 1);
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <move_r/move_r.hpp>
+
+template <move_r_support support, typename sym_t, typename pos_t>
+uint64_t move_r<support, sym_t, pos_t>::measure_query_time(const std::vector<inp_t>& patterns, uint8_t num_repetitions) const
+{
+    std::vector<pos_t> Occ;
+    auto time = now();
+
+    for (uint8_t rep = 0; rep < num_repetitions; rep++) {
+        for (const inp_t& P : patterns) {
+            if constexpr (supports_multiple_locate) {
+                locate(P, Occ);
+                Occ.clear();
+            } else {
+                count(P);
+            }
+        }
+    }
+
+    return time_diff_ns(time, now());
+}
+
+template <move_r_support support, typename sym_t, typename pos_t>
+void move_r<support, sym_t, pos_t>::tune(
+    inp_t& input, const std::vector<inp_t>& patterns,
+    move_r_tuning_params tuning, move_r_params params)
+{
+    bool log = params.log;
+    params.log = false;
+    params.mf_idx = NULL;
+    params.mf_mds = NULL;
+
+    // query time and size of the best configuration found so far
+    uint64_t best_time = std::numeric_limits<uint64_t>::max();
+    uint64_t best_size = std::numeric_limits<uint64_t>::max();
+
+    // returns whether a configuration with query time t and size s is better than the best configuration so far; a
+    // configuration within the memory budget is always better than one exceeding it, and among the configurations
+    // exceeding the budget, the smallest one is chosen
+    auto is_better = [&](uint64_t t, uint64_t s) {
+        bool fits = s <= tuning.max_size_in_bytes;
+        bool best_fits = best_size <= tuning.max_size_in_bytes;
+
+        if (fits != best_fits) return fits;
+        return fits ? t < best_time : s < best_size;
+    };
+
+    if constexpr (!has_rlzdsa) tuning.sr_scp = { params.sr_scp };
+    if constexpr (!byte_alphabet) tuning.max_scan_l_ = { params.max_scan_l_ };
+    if (tuning.a.empty()) tuning.a = { params.a };
+    if (tuning.sr_scp.empty()) tuning.sr_scp = { params.sr_scp };
+    if (tuning.max_scan_l_.empty()) tuning.max_scan_l_ = { params.max_scan_l_ };
+
+    // build the index once and obtain the candidates for the other balancing parameters by rebalancing it
+    if (log) {
+        std::cout << "building the index with a = " << tuning.a[0] << std::flush;
+    }
+
+    auto time = now();
+    params.a = tuning.a[0];
+    std::stringstream base_stream;
+    move_r<support, sym_t, pos_t>(input, params).serialize(base_stream);
+    if (log) time = log_runtime(time);
+
+    for (uint16_t a_cand : tuning.a) {
+        move_r<support, sym_t, pos_t> cand;
+        base_stream.seekg(0, std::ios::beg);
+        cand.load(base_stream);
+
+        if (cand.a != a_cand) {
+            if (log) {
+                time = now();
+                std::cout << "rebalancing the index to a = " << a_cand << std::flush;
+            }
+
+            cand.rebalance(a_cand, params.num_threads);
+            if (log) time = log_runtime(time);
+        }
+
+        // the best configuration of the candidate
+        pos_t cand_sr_scp = cand.sr_scp;
+        pos_t cand_max_scan_l_ = cand.max_scan_l_;
+        bool cand_improved = false;
+
+        // at first choose the sample rate (it determines the size), then the scan distance over L' (it does not)
+        for (uint16_t sr : tuning.sr_scp) {
+            if constexpr (has_rlzdsa) {
+                if (cand.sr_scp != sr) cand.set_sample_rate_rlzdsa(sr);
+            }
+
+            uint64_t t = cand.measure_query_time(patterns, tuning.num_repetitions);
+            uint64_t s = cand.size_in_bytes();
+
+            if (log) {
+                std::cout << "a = " << a_cand << ", sr_scp = " << sr << ", max_scan_l' = " << cand.max_scan_l_
+                          << ": size = " << format_size(s) << ", time = " << format_time(t) << std::endl;
+            }
+
+            if (is_better(t, s)) {
+                best_time = t;
+                best_size = s;
+                cand_sr_scp = cand.sr_scp;
+                cand_improved = true;
+            }
+        }
+
+        if (!cand_improved) {
+            continue;
+        }
+
+        if constexpr (has_rlzdsa) {
+            if (cand.sr_scp != cand_sr_scp) cand.set_sample_rate_rlzdsa(cand_sr_scp);
+        }
+
+        for (uint16_t max_scan : tuning.max_scan_l_) {
+            if (max_scan == cand_max_scan_l_) {
+                continue;
+            }
+
+            cand.max_scan_l_ = max_scan;
+            uint64_t t = cand.measure_query_time(patterns, tuning.num_repetitions);
+
+            if (log) {
+                std::cout << "a = " << a_cand << ", sr_scp = " << cand.sr_scp << ", max_scan_l' = " << max_scan
+                          << ": size = " << format_size(best_size) << ", time = " << format_time(t) << std::endl;
+            }
+
+            // the size is unchanged, so if it exceeds the budget, the query time does not matter
+            if (is_better(t, best_size)) {
+                best_time = t;
+                cand_max_scan_l_ = max_scan;
+            }
+        }
+
+        cand.max_scan_l_ = cand_max_scan_l_;
+        *this = std::move(cand);
+    }
+
+    if (log) {
+        std::cout << std::endl << "chose a = " << a << ", sr_scp = " << sr_scp << ", max_scan_l' = " << max_scan_l_
+                  << " (size = " << format_size(best_size) << ")" << std::endl;
+    }
+}
\ No newline at end of file
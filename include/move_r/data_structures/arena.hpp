@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief bump allocator that hands out memory from large blocks; freed allocations are kept in one free list per
+ *        size class and reused by later allocations of the same size, but the blocks are only returned to the system
+ *        at once, when the arena is released or destroyed; destructors of the objects placed in the arena are not
+ *        called; an arena must not be used by multiple threads concurrently
+ */
+class arena {
+protected:
+    static constexpr uint64_t min_block_size = 1 << 16; // size of the first block in bytes
+    static constexpr uint64_t max_block_size = 1 << 26; // maximum size of a block in bytes (unless a larger allocation is requested)
+    static constexpr uint64_t huge_page_size = 1 << 21; // size of a (transparent) huge page in bytes
+
+    std::vector<void*> blocks; // the blocks, as returned by malloc
+    char* cur = NULL; // next free byte in the current block
+    char* end = NULL; // end of the current block
+    uint64_t block_size = min_block_size; // size of the next block in bytes
+    uint64_t size = 0; // total size of all blocks in bytes
+    bool huge_pages = false; // controls whether the blocks are backed by transparent huge pages
+
+    /* free lists of deallocated memory, one per size class <size, alignment>; the first 8 bytes of each free
+    allocation store a pointer to the next free allocation of its class */
+    std::vector<std::tuple<uint64_t, uint64_t, void*>> free_lists;
+
+    /**
+     * @brief returns the size class of an allocation of size_alloc bytes (allocations are at least 8 bytes large)
+     * @param size_alloc number of bytes
+     * @return size class
+     */
+    inline static uint64_t size_class(uint64_t size_alloc)
+    {
+        return std::max<uint64_t>(size_alloc, sizeof(void*));
+    }
+
+    /**
+     * @brief returns the alignment used for an allocation with the requested alignment (at least that of a pointer,
+     * s.t. freed allocations can store the free list pointer)
+     * @param alignment requested alignment
+     * @return alignment used
+     */
+    inline static uint64_t alignment_class(uint64_t alignment)
+    {
+        return std::max<uint64_t>(alignment, alignof(void*));
+    }
+
+    /**
+     * @brief returns the free list of the size class <size_alloc, alignment>, where it is created if it does not exist
+     * @param size_alloc size class
+     * @param alignment alignment
+     * @return head of the free list
+     */
+    inline void*& free_list(uint64_t size_alloc, uint64_t alignment)
+    {
+        // there are only few size classes (e.g., the node types of a b-tree), so a linear search suffices
+        for (auto& [size_fl, alignment_fl, head] : free_lists) {
+            if (size_fl == size_alloc && alignment_fl == alignment) {
+                return head;
+            }
+        }
+
+        free_lists.emplace_back(size_alloc, alignment, (void*)NULL);
+        return std::get<2>(free_lists.back());
+    }
+
+    /**
+     * @brief allocates a new block with at least min_size bytes and makes it the current block
+     * @param min_size minimum size of the new block in bytes
+     */
+    void new_block(uint64_t min_size)
+    {
+        uint64_t size_block = std::max(block_size, min_size);
+        block_size = std::min(2 * block_size, max_block_size);
+
+        // the blocks are allocated with malloc, s.t. the memory allocation is still tracked by malloc_count (if it is linked)
+        void* raw = std::malloc(huge_pages ? size_block + huge_page_size : size_block);
+
+        if (raw == NULL) {
+            throw std::bad_alloc();
+        }
+
+        char* mem = (char*)raw;
+
+        if (huge_pages) {
+            mem = (char*)((((uint64_t)raw) + huge_page_size - 1) & ~(huge_page_size - 1));
+            #ifdef MADV_HUGEPAGE
+            madvise(mem, size_block, MADV_HUGEPAGE);
+            #endif
+        }
+
+        blocks.emplace_back(raw);
+        cur = mem;
+        end = mem + size_block;
+        size += size_block;
+    }
+
+    /**
+     * @brief moves another arena into this arena
+     * @param other the arena to move
+     */
+    void move_from_other(arena&& other)
+    {
+        release();
+        blocks = std::move(other.blocks);
+        cur = other.cur;
+        end = other.end;
+        block_size = other.block_size;
+        size = other.size;
+        huge_pages = other.huge_pages;
+
+        free_lists = std::move(other.free_lists);
+
+        other.blocks.clear();
+        other.free_lists.clear();
+        other.cur = other.end = NULL;
+        other.size = 0;
+    }
+
+public:
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    arena(arena&& other) { move_from_other(std::move(other)); }
+    arena& operator=(arena&& other) { move_from_other(std::move(other)); return *this; }
+    ~arena() { release(); }
+
+    /**
+     * @brief creates an empty arena
+     * @param huge_pages controls whether the blocks are backed by transparent huge pages
+     */
+    arena(bool huge_pages = false)
+    {
+        this->huge_pages = huge_pages;
+        if (huge_pages) block_size = huge_page_size;
+    }
+
+    /**
+     * @brief allocates size_alloc bytes aligned to alignment bytes
+     * @param size_alloc number of bytes
+     * @param alignment alignment (must be a power of two)
+     * @return pointer to the allocated memory
+     */
+    inline void* allocate(uint64_t size_alloc, uint64_t alignment)
+    {
+        size_alloc = size_class(size_alloc);
+        alignment = alignment_class(alignment);
+
+        // reuse a freed allocation of the same size class, if there is one
+        if (!free_lists.empty()) {
+            void*& head = free_list(size_alloc, alignment);
+
+            if (head != NULL) {
+                void* ptr = head;
+                head = *reinterpret_cast<void**>(ptr);
+                return ptr;
+            }
+        }
+
+        char* ptr = (char*)((((uint64_t)cur) + alignment - 1) & ~(alignment - 1));
+
+        if (cur == NULL || ptr + size_alloc > end) [[unlikely]] {
+            new_block(size_alloc + alignment);
+            ptr = (char*)((((uint64_t)cur) + alignment - 1) & ~(alignment - 1));
+        }
+
+        cur = ptr + size_alloc;
+        return ptr;
+    }
+
+    /**
+     * @brief frees size_alloc bytes allocated with allocate(size_alloc, alignment), s.t. they can be reused by a later
+     * allocation of the same size
+     * @param ptr pointer to the allocated memory
+     * @param size_alloc number of bytes
+     * @param alignment alignment
+     */
+    inline void deallocate(void* ptr, uint64_t size_alloc, uint64_t alignment)
+    {
+        void*& head = free_list(size_class(size_alloc), alignment_class(alignment));
+        *reinterpret_cast<void**>(ptr) = head;
+        head = ptr;
+    }
+
+    /**
+     * @brief creates an object of type T in the arena
+     * @param args arguments to pass to the constructor of T
+     * @return pointer to the object
+     */
+    template <typename T, typename... args_t>
+    inline T* create(args_t&&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<args_t>(args)...);
+    }
+
+    /**
+     * @brief releases all memory of the arena at once
+     */
+    void release()
+    {
+        for (void* raw : blocks) {
+            std::free(raw);
+        }
+
+        blocks.clear();
+        blocks.shrink_to_fit();
+        free_lists.clear();
+        cur = end = NULL;
+        block_size = huge_pages ? huge_page_size : min_block_size;
+        size = 0;
+    }
+
+    /**
+     * @brief returns the size of all blocks of the arena in bytes
+     * @return size of all blocks of the arena in bytes
+     */
+    inline uint64_t size_in_bytes() const
+    {
+        return size;
+    }
+};
+
+/**
+ * @brief allocator that allocates memory from an arena (deallocated memory is reused by the arena) or, if no
+ *        arena is given, from the global allocator; it can be used with the standard containers and the gtl b-trees
+ * @tparam T value type
+ */
+template <typename T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    arena* ar = NULL; // the arena to allocate from, or NULL, if the global allocator is used
+
+    arena_allocator() = default;
+
+    /**
+     * @brief creates an allocator that allocates memory from the arena ar
+     * @param ar an arena
+     */
+    arena_allocator(arena* ar)
+        : ar(ar)
+    {
+    }
+
+    /**
+     * @brief creates an allocator that allocates memory from the same arena as other
+     * @param other another arena_allocator
+     */
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other)
+        : ar(other.ar)
+    {
+    }
+
+    inline T* allocate(size_t n)
+    {
+        if (ar == NULL) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(ar->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    inline void deallocate(T* ptr, size_t n)
+    {
+        if (ar == NULL) {
+            ::operator delete(ptr);
+        } else {
+            ar->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+    }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U>& other) const
+    {
+        return ar == other.ar;
+    }
+
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& other) const
+    {
+        return ar != other.ar;
+    }
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <move_r/data_structures/arena.hpp>
 
 /**
  * @brief balanced binary search tree, for each node |height of left child - height of right child| <= 1 holds
@@ -184,6 +185,7 @@ protected:
     avl_node* lst = NULL; // last node (node with the greatest value)
     uint64_t s = 0; // size
     uint8_t h = 0; // height
+    arena* ar = NULL; // arena the nodes are allocated from, or NULL, if they are allocated individually
 
     inline static bool lt(const T& v1, const T& v2) { return Compare()(v1, v2); }; // comparison function "less than" on values of type T
     inline static bool gt(const T& v1, const T& v2) { return lt(v2, v1); }; // comparison function "greater than" on values of type T
@@ -518,12 +520,24 @@ protected:
         this->lst = other.lst;
         this->s = other.s;
         this->h = other.h;
+        this->ar = other.ar;
 
         other.r = NULL;
         other.fst = NULL;
         other.lst = NULL;
         other.s = 0;
         other.h = 0;
+        other.ar = NULL;
+    }
+
+    /**
+     * @brief creates a node with value v in the arena, or individually if the avl_tree has no arena
+     * @param v value
+     * @return the newly created node
+     */
+    inline avl_node* new_node(T& v)
+    {
+        return ar != NULL ? ar->template create<avl_node>(v) : new avl_node(v);
     }
 
 public:
@@ -533,12 +547,22 @@ public:
     avl_tree& operator=(avl_tree&& other) { move_from_other(std::move(other)); return *this; }
     avl_tree& operator=(const avl_tree& other) { copy_from_other(other); return *this; }
 
+    /**
+     * @brief creates an empty avl_tree that allocates its nodes from the arena ar; the nodes
+     *        are not deleted by the avl_tree, but released with the arena
+     * @param ar an arena
+     */
+    avl_tree(arena* ar)
+    {
+        this->ar = ar;
+    }
+
     /**
      * @brief deletes the avl_tree but not it's nodes
      */
     ~avl_tree()
     {
-        if (r != NULL)
+        if (r != NULL && ar == NULL)
             r->delete_subtree();
         fst = lst = r = NULL;
     }
@@ -576,7 +600,7 @@ public:
     inline void delete_nodes()
     {
         if (!empty()) {
-            r->delete_subtree();
+            if (ar == NULL) r->delete_subtree();
             fst = lst = r = NULL;
             h = s = 0;
         }
@@ -673,7 +697,7 @@ public:
     inline avl_node* emplace_hint(T&& v, avl_node* n)
     {
         if (empty()) {
-            r = new avl_node(v);
+            r = new_node(v);
             h = s = 1;
             fst = lst = r;
             return r;
@@ -684,7 +708,7 @@ public:
                 n->v = v;
                 return n;
             } else {
-                avl_node* n_new = new avl_node(v);
+                avl_node* n_new = new_node(v);
 
                 if (lt(n_new->v, n->v)) {
                     n->lc = n_new;
@@ -1028,7 +1052,7 @@ public:
      */
     class avl_it {
     protected:
-        avl_tree* t; // the avl_tree, the iterator iterates through
+        const avl_tree* t; // the avl_tree, the iterator iterates through
         avl_node* cur; // the node the iterator points to
 
     public:
@@ -1037,7 +1061,7 @@ public:
          * @param t an avl_tree
          * @param n an avl_node in t
          */
-        avl_it(avl_tree* t, avl_node* n)
+        avl_it(const avl_tree* t, avl_node* n)
         {
             this->t = t;
             this->cur = n;
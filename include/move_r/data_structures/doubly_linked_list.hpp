@@ -1,5 +1,7 @@
 #pragma once
 
+#include <move_r/data_structures/arena.hpp>
+
 /**
  * @brief doubly linked list
  * @tparam T value type
@@ -80,6 +82,7 @@ protected:
     doubly_linked_list_node* hd = NULL; // first node
     doubly_linked_list_node* tl = NULL; // last node
     uint64_t s = 0; // size
+    arena* ar = NULL; // arena the nodes are allocated from, or NULL, if they are allocated individually
 
     /**
      * @brief creates a copy of another list
@@ -108,10 +111,22 @@ protected:
         this->hd = other.hd;
         this->tl = other.tl;
         this->s = other.s;
+        this->ar = other.ar;
 
         other.hd = NULL;
         other.tl = NULL;
         other.s = NULL;
+        other.ar = NULL;
+    }
+
+    /**
+     * @brief creates a node with value v in the arena, or individually if the list has no arena
+     * @param v value
+     * @return the newly created node
+     */
+    inline doubly_linked_list_node* new_node(T&& v)
+    {
+        return ar != NULL ? ar->template create<doubly_linked_list_node>(std::move(v)) : new doubly_linked_list_node(std::move(v));
     }
 
 public:
@@ -121,6 +136,16 @@ public:
     doubly_linked_list& operator=(doubly_linked_list&& other) { move_from_other(std::move(other)); return *this; }
     doubly_linked_list& operator=(const doubly_linked_list& other) { copy_from_other(other); return *this; }
 
+    /**
+     * @brief creates an empty list that allocates its nodes from the arena ar; the nodes
+     *        are not deleted by the list, but released with the arena
+     * @param ar an arena
+     */
+    doubly_linked_list(arena* ar)
+    {
+        this->ar = ar;
+    }
+
     /**
      * @brief deletes all nodes of the list and the lsit
      */
@@ -200,7 +225,7 @@ public:
      */
     inline doubly_linked_list_node* push_front(T&& v)
     {
-        return push_front_node(new doubly_linked_list_node(v));
+        return push_front_node(new_node(std::move(v)));
     }
 
     /**
@@ -210,7 +235,7 @@ public:
      */
     inline doubly_linked_list_node* push_front(T& v)
     {
-        return push_front_node(new doubly_linked_list_node(std::move(v)));
+        return push_front_node(new_node(std::move(v)));
     }
 
     /**
@@ -220,7 +245,7 @@ public:
      */
     inline doubly_linked_list_node* push_back(T&& v)
     {
-        return push_back_node(new doubly_linked_list_node(v));
+        return push_back_node(new_node(std::move(v)));
     }
 
     /**
@@ -230,7 +255,7 @@ public:
      */
     inline doubly_linked_list_node* push_back(T& v)
     {
-        return push_back_node(new doubly_linked_list_node(std::move(v)));
+        return push_back_node(new_node(std::move(v)));
     }
 
     /**
@@ -241,7 +266,7 @@ public:
      */
     inline doubly_linked_list_node* insert_before(T&& v, doubly_linked_list_node* n)
     {
-        return insert_before_node(new doubly_linked_list_node(v), n);
+        return insert_before_node(new_node(std::move(v)), n);
     }
 
     /**
@@ -252,7 +277,7 @@ public:
      */
     inline doubly_linked_list_node* insert_before(T& v, doubly_linked_list_node* n)
     {
-        return insert_before_node(new doubly_linked_list_node(std::move(v)), n);
+        return insert_before_node(new_node(std::move(v)), n);
     }
 
     /**
@@ -263,7 +288,7 @@ public:
      */
     inline doubly_linked_list_node* insert_after(T&& v, doubly_linked_list_node* n)
     {
-        return insert_after_node(new doubly_linked_list_node(v), n);
+        return insert_after_node(new_node(std::move(v)), n);
     }
 
     /**
@@ -274,7 +299,7 @@ public:
      */
     inline doubly_linked_list_node* insert_after(T& v, doubly_linked_list_node* n)
     {
-        return insert_after_node(new doubly_linked_list_node(std::move(v)), n);
+        return insert_after_node(new_node(std::move(v)), n);
     }
 
     /**
@@ -404,7 +429,9 @@ public:
      */
     void delete_nodes()
     {
-        if (!empty()) {
+        if (!empty() && ar != NULL) {
+            disconnect_nodes();
+        } else if (!empty()) {
             doubly_linked_list_node* n = hd;
             
             for (uint64_t i = 1; i < s; i++) {
@@ -422,7 +449,7 @@ public:
      */
     class dll_it {
     protected:
-        doubly_linked_list<T>* l; // the list, the iterator iterates through
+        const doubly_linked_list<T>* l; // the list, the iterator iterates through
         doubly_linked_list_node* cur; // the node the iterator points to
 
     public:
@@ -431,7 +458,7 @@ public:
          * @param l a list
          * @param n a node in l
          */
-        dll_it(doubly_linked_list<T>* l, doubly_linked_list_node* n)
+        dll_it(const doubly_linked_list<T>* l, doubly_linked_list_node* n)
         {
             this->l = l;
             this->cur = n;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <move_r/data_structures/arena.hpp>
+
 /**
  * @brief dynamically-growing insert-only no-copy data structure
  * @tparam T value type
@@ -8,6 +10,7 @@ template <typename T>
 class dynamic_insert_only_no_copy {
 protected:
     std::vector<std::vector<T>> vectors; // vectors that store the elements
+    arena* ar = NULL; // arena that stores the elements instead of the vectors, or NULL
 
 public:
     dynamic_insert_only_no_copy() = default;
@@ -22,6 +25,16 @@ public:
         vectors.back().reserve(size);
     }
 
+    /**
+     * @brief creates an empty data structure that stores its elements in the arena ar; the elements
+     *        are released with the arena
+     * @param ar an arena
+     */
+    dynamic_insert_only_no_copy(arena* ar)
+    {
+        this->ar = ar;
+    }
+
     /**
      * @brief clears all vectors
      */
@@ -39,6 +52,10 @@ public:
      */
     inline T* emplace_back(T&& v)
     {
+        if (ar != NULL) {
+            return ar->template create<T>(std::move(v));
+        }
+
         if (vectors.back().size() == vectors.back().capacity()) {
             size_t new_capacity = 2 * vectors.back().capacity();
             vectors.emplace_back(std::vector<T>());
@@ -57,11 +57,11 @@ void move_data_structure<pos_t>::construction::balance_v1_seq()
     std::vector<std::tuple<pos_t, pos_t, pair_t>> intervals_to_check;
     while (!T_e_v1.empty()) {
         /* Find the pair creating the first a-heavy output interval [q_j, q_j + d_j)
-        and remove it from T_e_v1. */
+        and remove it from T_e_v1 (its node is released with the arena). */
         min = T_e_v1.min();
         p_j = min->v.first;
         q_j = min->v.second;
-        delete T_e_v1.remove(min->v);
+        T_e_v1.remove(min->v);
 
         // Find the a+1-st input interval in [q_j, q_j + d_j) and set d = p_{i+a} - q_j.
         /* d is the smallest integer, so that [q_j, q_j + d) has a incoming edges in the
@@ -173,12 +173,9 @@ void move_data_structure<pos_t>::construction::balance_v2_seq()
                     min->v = te_pair_t_v2 { ln_ZpA, tn_Y };
                 } else {
                     // and is not the first a-heavy output interval
+                    // the nodes not in nodes_te are released with the arena
                     T_e_v2.remove_node(min);
 
-                    if (min < &nodes_te.front() || &nodes_te.back() < min) {
-                        delete min;
-                    }
-
                     T_e_v2.insert(te_pair_t_v2 { ln_ZpA, tn_Y });
                 }
             }
@@ -188,11 +185,8 @@ void move_data_structure<pos_t>::construction::balance_v2_seq()
                 min->v = te_pair_t_v2 { ln_Ip2A, tn_NEW };
             } else {
                 // there is no new a-heavy output interval
+                // the nodes not in nodes_te are released with the arena
                 T_e_v2.remove_node(min);
-
-                if (min < &nodes_te.front() || &nodes_te.back() < min) {
-                    delete min;
-                }
             }
         }
     }
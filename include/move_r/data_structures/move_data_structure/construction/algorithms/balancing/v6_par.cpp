@@ -0,0 +1,142 @@
+#pragma once
+
+#include <ips4o.hpp>
+#include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
+
+template <typename pos_t>
+template <typename key_t>
+void move_data_structure<pos_t>::construction::merge_v6(pair_arr_t& P, pair_arr_t& N, key_t key)
+{
+    auto comp = [&key](const pair_t& p1, const pair_t& p2) { return key(p1) < key(p2); };
+    pair_arr_t P_;
+    no_init_resize(P_, P.size() + N.size());
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+
+        // thread i_p merges P[b_P..e_P-1] with the pairs in N whose keys lie in [key(P[b_P]), key(P[e_P]))
+        uint64_t b_P = i_p * (P.size() / p);
+        uint64_t e_P = i_p == p - 1 ? P.size() : (i_p + 1) * (P.size() / p);
+
+        // returns the number of pairs in N that have to be placed before P[i]
+        auto num_before = [&](uint64_t i) -> uint64_t {
+            if (i == 0) return 0;
+            if (i == P.size()) return N.size();
+            return std::lower_bound(N.begin(), N.end(), P[i], comp) - N.begin();
+        };
+
+        uint64_t b_N = num_before(b_P);
+        uint64_t e_N = num_before(e_P);
+
+        std::merge(
+            P.begin() + b_P, P.begin() + e_P,
+            N.begin() + b_N, N.begin() + e_N,
+            P_.begin() + b_P + b_N, comp);
+    }
+
+    std::swap(P, P_);
+}
+
+template <typename pos_t>
+void move_data_structure<pos_t>::construction::balance_v6_par()
+{
+    if (log)
+        log_message("balancing");
+
+    // number of output intervals per work unit
+    constexpr pos_t chunk_size = 4096;
+    // N_c[c] stores the pairs created in the c-th work unit in the current round in ascending order of q_i
+    std::vector<pair_arr_t> N_c;
+    // n_c[c] = number of pairs created in the work units before the c-th work unit in the current round
+    std::vector<pos_t> n_c;
+    // the pairs created in the current round
+    pair_arr_t N;
+    // number of rounds
+    uint64_t num_rounds = 0;
+
+    while (true) {
+        // current number of intervals
+        pos_t k_cur = P_out_v6.size();
+        // number of work units in the current round
+        pos_t num_chunks = (k_cur + chunk_size - 1) / chunk_size;
+        N_c.resize(num_chunks);
+        n_c.resize(num_chunks + 1);
+        n_c[0] = 0;
+
+        // the work units are small and distributed dynamically, s.t. the threads stay busy even if k is small
+        #pragma omp parallel for num_threads(p) schedule(dynamic)
+        for (uint64_t c = 0; c < num_chunks; c++) {
+            // the c-th work unit checks the output intervals [q_j, q_j + d_j) for j in [b..e-1] (in the order of P_out_v6)
+            pos_t b = c * chunk_size;
+            pos_t e = std::min<pos_t>(b + chunk_size, k_cur);
+
+            N_c[c].clear();
+
+            // index in P_in_v6 of the first input interval starting in [q_j, q_j + d_j)
+            pos_t i = std::lower_bound(P_in_v6.begin(), P_in_v6.end(), P_out_v6[b].second,
+                [](const pair_t& pr, pos_t q) { return pr.first < q; }) - P_in_v6.begin();
+
+            for (pos_t j = b; j < e; j++) {
+                pos_t q_j = P_out_v6[j].second; // q_j
+                pos_t q_J_ = j == k_cur - 1 ? n : P_out_v6[j + 1].second; // q_j'
+                pos_t i_ = i; // index in P_in_v6 of the first input interval starting at or after q_j'
+
+                while (i_ < k_cur && P_in_v6[i_].first < q_J_) {
+                    i_++;
+                }
+
+                /* [q_j, q_j + d_j) contains i_ - i input interval starting positions; if it is a-heavy, we split it at
+                   q_j + d = p_{i+a} and repeat this for the remaining part, as long as it is a-heavy */
+                for (pos_t t = a; i + t + a <= i_; t += a) {
+                    pos_t qj_pd = P_in_v6[i + t].first; // q_j + d
+                    N_c[c].emplace_back(pair_t { P_out_v6[j].first + (qj_pd - q_j), qj_pd });
+                }
+
+                i = i_;
+            }
+
+            n_c[c + 1] = N_c[c].size();
+        }
+
+        for (pos_t c = 1; c <= num_chunks; c++) {
+            n_c[c] += n_c[c - 1];
+        }
+
+        // if no pair has been created, then there is no a-heavy output interval left
+        if (n_c[num_chunks] == 0) {
+            break;
+        }
+
+        num_rounds++;
+
+        // concatenate N_c[0..num_chunks-1], which yields the new pairs in ascending order of q_i
+        no_init_resize(N, n_c[num_chunks]);
+
+        #pragma omp parallel for num_threads(p) schedule(dynamic)
+        for (uint64_t c = 0; c < num_chunks; c++) {
+            std::copy(N_c[c].begin(), N_c[c].end(), N.begin() + n_c[c]);
+        }
+
+        merge_v6(P_out_v6, N, [](const pair_t& pr) { return pr.second; });
+
+        // sort the new pairs by p_i and merge them into P_in_v6
+        auto comp_in = [](const pair_t& p1, const pair_t& p2) { return p1.first < p2.first; };
+        if (p > 1) {
+            ips4o::parallel::sort(N.begin(), N.end(), comp_in, p);
+        } else {
+            ips4o::sort(N.begin(), N.end(), comp_in);
+        }
+
+        merge_v6(P_in_v6, N, [](const pair_t& pr) { return pr.first; });
+    }
+
+    if (log) {
+        if (mf != NULL) {
+            *mf << " time_balance=" << time_diff_ns(time);
+            *mf << " balancing_rounds=" << num_rounds;
+        }
+        std::cout << " (" << num_rounds << " rounds)";
+        time = log_runtime(time);
+    }
+}
\ No newline at end of file
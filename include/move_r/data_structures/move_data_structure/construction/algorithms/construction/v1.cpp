@@ -3,7 +3,8 @@
 #include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
 
 template <typename pos_t>
-void move_data_structure<pos_t>::construction::build_tin_tout_v1()
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::build_tin_tout_v1(pair_arr_in_t& I)
 {
     if (log) log_message("building T_in");
 
@@ -4,7 +4,8 @@
 #include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
 
 template <typename pos_t>
-void move_data_structure<pos_t>::construction::build_pi_for_I()
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::build_pi_for_I(pair_arr_in_t& I)
 {
     no_init_resize(pi, k);
 
@@ -15,9 +16,9 @@ void move_data_structure<pos_t>::construction::build_pi_for_I()
     }
 
     // sort pi by the output interval starting positions in I
-    auto comp_pi = [this](pos_t i, pos_t j) { return I[i].second < I[j].second; };
+    auto comp_pi = [&I](pos_t i, pos_t j) { return I[i].second < I[j].second; };
     if (p > 1) {
-        ips4o::parallel::sort(pi.begin(), pi.end(), comp_pi);
+        ips4o::parallel::sort(pi.begin(), pi.end(), comp_pi, p);
     } else {
         ips4o::sort(pi.begin(), pi.end(), comp_pi);
     }
@@ -37,14 +38,15 @@ void move_data_structure<pos_t>::construction::build_pi_for_dq()
     // sort pi by D_q
     auto comp_pi = [this](pos_t i, pos_t j) { return D_q[i] < D_q[j]; };
     if (p > 1) {
-        ips4o::parallel::sort(pi.begin(), pi.end(), comp_pi);
+        ips4o::parallel::sort(pi.begin(), pi.end(), comp_pi, p);
     } else {
         ips4o::sort(pi.begin(), pi.end(), comp_pi);
     }
 }
 
 template <typename pos_t>
-void move_data_structure<pos_t>::construction::calculate_seperation_positions_for_I()
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::calculate_seperation_positions_for_I(pair_arr_in_t& I)
 {
     s.resize(p + 1);
     s[0] = 0;
@@ -75,7 +75,8 @@ inline typename move_data_structure<pos_t>::construction::lin_node_t_v2v3v4* mov
 }
 
 template <typename pos_t>
-void move_data_structure<pos_t>::construction::build_lin_tout_v2v3v4()
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::build_lin_tout_v2v3v4(pair_arr_in_t& I)
 {
     L_in_v2v3v4.resize(p);
     T_out_v2v3v4.resize(p);
@@ -83,7 +84,7 @@ void move_data_structure<pos_t>::construction::build_lin_tout_v2v3v4()
     if (log)
         log_message("building pi");
 
-    build_pi_for_I();
+    build_pi_for_I(I);
 
     if (log) {
         if (mf != NULL)
@@ -92,7 +93,7 @@ void move_data_structure<pos_t>::construction::build_lin_tout_v2v3v4()
         log_message("building L_in");
     }
 
-    calculate_seperation_positions_for_I();
+    calculate_seperation_positions_for_I(I);
 
     (*reinterpret_cast<
          std::vector<
@@ -211,7 +212,7 @@ void move_data_structure<pos_t>::construction::build_lin_tout_v2v3v4()
     new_nodes_2v3v4.reserve(p);
 
     for (uint16_t i = 0; i < p; i++) {
-        new_nodes_2v3v4.emplace_back(dynamic_insert_only_no_copy<tout_node_t_v2v3v4>(k / (double)(16 * p * (a - 1))));
+        new_nodes_2v3v4.emplace_back(dynamic_insert_only_no_copy<tout_node_t_v2v3v4>(&arenas[i]));
     }
 
     /* make sure each avl tree T_out_v2v3v4[i], with i in [0..p-1], contains a pair creating
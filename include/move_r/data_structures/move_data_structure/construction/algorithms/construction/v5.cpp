@@ -3,14 +3,15 @@
 #include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
 
 template <typename pos_t>
-void move_data_structure<pos_t>::construction::build_tin_tout_v5()
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::build_tin_tout_v5(pair_arr_in_t& I)
 {
     if (log)
         log_message("building pi");
 
     // build pi to construct T_out faster
-    build_pi_for_I();
-    calculate_seperation_positions_for_I();
+    build_pi_for_I(I);
+    calculate_seperation_positions_for_I(I);
 
     if (log) {
         if (mf != NULL)
@@ -19,7 +20,11 @@ void move_data_structure<pos_t>::construction::build_tin_tout_v5()
         log_message("building T_out");
     }
 
-    T_out_v5.resize(p);
+    T_out_v5.reserve(p);
+
+    for (uint16_t i = 0; i < p; i++) {
+        T_out_v5.emplace_back(out_cmp_v1v5(), arena_allocator<pair_t>(&arenas[i]));
+    }
 
     // build T_out_v5[0..p-1]
     #pragma omp parallel num_threads(p)
@@ -47,15 +52,22 @@ void move_data_structure<pos_t>::construction::build_tin_tout_v5()
         log_message("building T_in");
     }
 
-    T_in_v5.resize(p);
+    T_in_v5.reserve(p);
+
+    for (uint16_t i = 0; i < p; i++) {
+        T_in_v5.emplace_back(in_cmp_v1v5(), arena_allocator<pair_t>(&arenas[i]));
+    }
 
     // build T_in_v5[0..p-1]
     #pragma omp parallel num_threads(p)
     {
         uint16_t i_p = omp_get_thread_num();
 
-        if (x[i_p] < x[i_p + 1]) {
-            T_in_v5[i_p].insert(&I[x[i_p]], &I[x[i_p + 1]]);
+        pos_t b = x[i_p];
+        pos_t e = x[i_p + 1];
+
+        for (pos_t i = b; i < e; i++) {
+            T_in_v5[i_p].emplace_hint(T_in_v5[i_p].end(), I[i]);
         }
     }
 
@@ -104,7 +116,16 @@ void move_data_structure<pos_t>::construction::build_tin_tout_v5()
         log_message("splitting too long intervals");
     }
 
-    T_out_temp_v5.resize(p, std::vector<tout_t_v5>(p));
+    T_out_temp_v5.resize(p);
+
+    // T_out_temp_v5[i][j] is filled by thread j, so it allocates its nodes from arenas[j]
+    for (uint16_t i = 0; i < p; i++) {
+        T_out_temp_v5[i].reserve(p);
+
+        for (uint16_t j = 0; j < p; j++) {
+            T_out_temp_v5[i].emplace_back(out_cmp_v1v5(), arena_allocator<pair_t>(&arenas[j]));
+        }
+    }
 
     // iterate over all trees in T_in_v5 and split every input interval that is longer than l_max
     #pragma omp parallel num_threads(p)
@@ -132,16 +153,18 @@ void move_data_structure<pos_t>::construction::build_tin_tout_v5()
         }
     }
 
-    // merge T_out_v5 with T_out_temp_v5
+    // insert the pairs in T_out_temp_v5 into T_out_v5; merging would free the nodes of T_out_temp_v5[i_p][i] into
+    // arenas[i] while thread i allocates from it, so each thread only inserts copies into its own tree instead
     #pragma omp parallel num_threads(p)
     {
         uint16_t i_p = omp_get_thread_num();
 
         for (uint16_t i = 0; i < p; i++) {
-            T_out_v5[i_p].merge(T_out_temp_v5[i_p][i]);
+            T_out_v5[i_p].insert(T_out_temp_v5[i_p][i].begin(), T_out_temp_v5[i_p][i].end());
         }
     }
 
+    // the trees in T_out_temp_v5 free their nodes into the arenas of all threads, so destroy them sequentially
     T_out_temp_v5.clear();
     T_out_temp_v5.shrink_to_fit();
 
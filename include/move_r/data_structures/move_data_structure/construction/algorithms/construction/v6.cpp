@@ -0,0 +1,132 @@
+#pragma once
+
+#include <ips4o.hpp>
+#include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
+
+template <typename pos_t>
+template <typename pair_arr_in_t>
+void move_data_structure<pos_t>::construction::build_pin_pout_v6(pair_arr_in_t& I)
+{
+    if (log)
+        log_message("building P_in and splitting too long intervals");
+
+    // [0..p], k_p[i_p] = number of pairs created out of the pairs in I before thread i_p's section
+    std::vector<pos_t> k_p(p + 1, 0);
+
+    #pragma omp parallel num_threads(p)
+    {
+        uint16_t i_p = omp_get_thread_num();
+
+        pos_t b = i_p * (k / p);
+        pos_t e = i_p == p - 1 ? k : (i_p + 1) * (k / p);
+
+        // number of pairs created out of the pairs in I[b..e-1]
+        pos_t num_pairs = 0;
+
+        // every input interval of length d_i is split into lceil d_i / l_max rceil input intervals
+        for (pos_t i = b; i < e; i++) {
+            pos_t d_i = (i == k - 1 ? n : I[i + 1].first) - I[i].first;
+            num_pairs += (d_i - 1) / l_max + 1;
+        }
+
+        k_p[i_p + 1] = num_pairs;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (uint16_t i = 1; i <= p; i++) {
+                k_p[i] += k_p[i - 1];
+            }
+
+            no_init_resize(P_in_v6, k_p[p]);
+        }
+
+        pos_t j = k_p[i_p];
+
+        for (pos_t i = b; i < e; i++) {
+            pos_t d_i = (i == k - 1 ? n : I[i + 1].first) - I[i].first;
+
+            for (uint64_t o = 0; o < d_i; o += l_max) {
+                P_in_v6[j] = pair_t { I[i].first + o, I[i].second + o };
+                j++;
+            }
+        }
+    }
+
+    if (delete_i) {
+        // Now, we do not need I anymore.
+        I.clear();
+        I.shrink_to_fit();
+    }
+
+    if (log) {
+        if (mf != NULL)
+            *mf << " time_build_pin=" << time_diff_ns(time);
+        time = log_runtime(time);
+        log_message("building P_out");
+    }
+
+    no_init_resize(P_out_v6, P_in_v6.size());
+
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t i = 0; i < P_in_v6.size(); i++) {
+        P_out_v6[i] = P_in_v6[i];
+    }
+
+    // sort P_out_v6 by the output interval starting positions
+    auto comp_out = [](const pair_t& p1, const pair_t& p2) { return p1.second < p2.second; };
+    if (p > 1) {
+        ips4o::parallel::sort(P_out_v6.begin(), P_out_v6.end(), comp_out, p);
+    } else {
+        ips4o::sort(P_out_v6.begin(), P_out_v6.end(), comp_out);
+    }
+
+    if (log) {
+        if (mf != NULL)
+            *mf << " time_build_pout=" << time_diff_ns(time);
+        time = log_runtime(time);
+    }
+}
+
+template <typename pos_t>
+void move_data_structure<pos_t>::construction::build_dp_dq_v6()
+{
+    k_ = P_in_v6.size();
+
+    P_out_v6.clear();
+    P_out_v6.shrink_to_fit();
+
+    // resize the interleaved vectors in the move data structure
+    mds.resize(n, k_, width_l_);
+
+    if (log) {
+        float k__k = std::round(100.0 * k_ / k) / 100.0;
+        if (mf != NULL) {
+            *mf << " k=" << k;
+            *mf << " k_=" << k_;
+        }
+        std::cout << "k' = " << k_ << ", k'/k = " << k__k << std::endl;
+        log_message("building D_p and D_q");
+    }
+
+    D_q = interleaved_vectors<pos_t, pos_t>({ (uint8_t)(mds.omega_p / 8) });
+    D_q.resize_no_init(k_ + 1);
+    D_q.template set<0, pos_t>(k_, n);
+
+    // write the input interval starting positions to D_p (in the move data structure) and
+    // write the output interval starting positions to D_q
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t i = 0; i < k_; i++) {
+        mds.set_p(i, P_in_v6[i].first);
+        D_q.template set<0, pos_t>(i, P_in_v6[i].second);
+    }
+
+    P_in_v6.clear();
+    P_in_v6.shrink_to_fit();
+
+    if (log) {
+        if (mf != NULL)
+            *mf << " time_build_dp_dq=" << time_diff_ns(time);
+        time = log_runtime(time);
+    }
+}
\ No newline at end of file
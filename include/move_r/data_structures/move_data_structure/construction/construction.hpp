@@ -2,11 +2,13 @@
 
 #include <concurrentqueue.h>
 #include <gtl/btree.hpp>
+#include <move_r/data_structures/arena.hpp>
 #include <move_r/data_structures/avl_tree.hpp>
 #include <move_r/data_structures/doubly_linked_list.hpp>
 #include <move_r/data_structures/dynamic_insert_only_no_copy.hpp>
 #include <omp.h>
 #include <queue>
+#include <stdexcept>
 
 /**
  * @brief constructs a move data structure out of a disjoint interval sequence
@@ -48,12 +50,11 @@ public:
 
     // ############################# COMMON VARIABLES #############################
 
-    static constexpr uint8_t v = 5; // construction method
+    uint8_t v; // construction method, in [1..6]
     /* 1 + epsilon is the maximum factor, by which the number of intervals can increase in the
      * process of splitting too long intervals*/
     static constexpr double epsilon = 0.125;
     move_data_structure<pos_t>& mds; // the move data structure to construct
-    pair_arr_t& I; // the disjoint interval sequence to construct the move data structure out of
     pos_t n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
     pos_t k; // number of intervals in the (possibly a-heavy) inteval sequence I, 0 < k
     pos_t k_; // number of intervals in the a-balanced inteval sequence B_a(I), 0 < k <= k'
@@ -68,9 +69,15 @@ public:
     std::chrono::steady_clock::time_point time; // time point of the start of the last construction phase
     std::chrono::steady_clock::time_point time_start; // time point of the start of the entire construction
     interleaved_vectors<pos_t, pos_t> D_q; // [0..k'-1] output interval starting positions (ordered by the input interval starting positions)
-    std::vector<pos_t> pi; // [0..k'-1] permutation storing the order of the output interval starting postions
+    std::vector<packed_t<pos_t>> pi; // [0..k'-1] permutation storing the order of the output interval starting postions
     uint8_t width_l_; // width of L_
 
+    /**
+     * @brief [0..p-1] arenas; arenas[i_p] stores the nodes of the trees and lists that are created by thread i_p,
+     *        s.t. they are not allocated individually and can be released at once
+     */
+    std::vector<arena> arenas;
+
     /**
      * @brief [0..p-1] section start positions in the range [0..n], 0 = s[0] < s[1] < ... < s[p-1] = n.
      *        Before building T_out, s is chosen so that |L_in[0]| + |T_out[0]|
@@ -92,6 +99,7 @@ public:
 
     /**
      * @brief builds the move data structure mds
+     * @tparam pair_arr_in_t type of the disjoint interval sequence (pair_arr_t or packed_pair_arr_t)
      * @param mds the move data structure to build
      * @param I disjoint interval sequence
      * @param n n = p_{k-1} + d_{k-1}, k <= n
@@ -99,26 +107,31 @@ public:
      * @param params construction parameters
      * @param pi_mphi vector to move pi into after the construction
      */
+    template <typename pair_arr_in_t>
     construction(
         move_data_structure<pos_t>& mds,
-        pair_arr_t& I,
+        pair_arr_in_t& I,
         pos_t n,
         bool delete_i,
         uint8_t width_l_,
         mds_params params,
-        std::vector<pos_t>* pi_mphi = NULL)
+        std::vector<packed_t<pos_t>>* pi_mphi = NULL)
         : mds(mds)
-        , I(I)
     {
         this->n = n;
         this->k = I.size();
         this->a = params.a;
+        this->v = params.version;
         this->p = params.num_threads;
         this->delete_i = delete_i;
         this->log = params.log;
         this->mf = params.mf;
         this->width_l_ = width_l_;
 
+        if (v < 1 || v > 6) {
+            throw std::invalid_argument("the construction method must be in [1..6]");
+        }
+
         if (log) {
             time = now();
             time_start = time;
@@ -129,17 +142,25 @@ public:
         mds.k = k;
         two_a = 2 * a;
 
-        if (p > 1 && 1000 * p > k) {
-            p = std::max((pos_t)1, k / 1000);
-            if (log)
-                std::cout << "warning: p > k/1000, setting p to k/1000 ~ " << p << std::endl;
-        }
-
         if (v < 3 && p > 1) {
             p = 1;
         }
 
-        omp_set_num_threads(p);
+        /* v3, v4 and v5 split [0..n) into p static sections, which only pay off if each of them contains enough intervals;
+         * v6 splits its work into small units that are distributed dynamically, so it is used for small interval sequences */
+        if (3 <= v && v <= 5 && p > 1 && 1000 * p > k) {
+            if (log) {
+                std::cout << "using v6 instead of v" << std::to_string(v) << ", since 1000*p > k" << std::endl;
+            }
+
+            v = 6;
+        }
+
+        arenas.reserve(p);
+
+        for (uint16_t i = 0; i < p; i++) {
+            arenas.emplace_back(params.huge_pages);
+        }
 
         /* set omega_offs <- min {omega in {8,16,24,32,40} | n/(k2^omega) <= epsilon}, which ensures
          * k' <= k*(1+epsilon)*a/(a-1) */
@@ -155,18 +176,20 @@ public:
         l_max = pow(2, mds.omega_offs) - 1;
 
         // choose the correct construction method
-        if constexpr (v == 1) {
-            v1();
-        } else if constexpr (2 <= v && v <= 4) {
-            v2v3v4();
+        if (v == 1) {
+            v1(I);
+        } else if (2 <= v && v <= 4) {
+            v2v3v4(I);
+        } else if (v == 5) {
+            v5(I);
         } else {
-            v5();
+            v6(I);
         }
 
         // verify the correctness of the construction, if in debug mode and printing log messages
         #ifndef NDEBUG
         if (log) {
-            if constexpr (v == 1)
+            if (v == 1)
                 build_pi_for_dq();
             verify_correctness();
         }
@@ -194,8 +217,10 @@ public:
 
     /**
      * @brief builds the permutation pi for the output interval starting positions stored in I
+     * @param I disjoint interval sequence
      */
-    void build_pi_for_I();
+    template <typename pair_arr_in_t>
+    void build_pi_for_I(pair_arr_in_t& I);
 
     /**
      * @brief builds the permutation pi for the output interval starting positions stored in D_q
@@ -204,8 +229,10 @@ public:
 
     /**
      * @brief calcualtes s, x and u for I
+     * @param I disjoint interval sequence
      */
-    void calculate_seperation_positions_for_I();
+    template <typename pair_arr_in_t>
+    void calculate_seperation_positions_for_I(pair_arr_in_t& I);
 
     /**
      * @brief calculates s, x and u for D_p in mds and D_q
@@ -217,6 +244,16 @@ public:
      */
     void verify_correctness();
 
+    /**
+     * @brief releases all nodes stored in the arenas at once; must only be called after the trees and lists,
+     *        whose nodes are stored in the arenas, are not needed anymore
+     */
+    void release_arenas()
+    {
+        arenas.clear();
+        arenas.shrink_to_fit();
+    }
+
     // ############################# V1 #############################
 
     using tin_t_v1 = avl_tree<pair_t, in_cmp_v1v5>;
@@ -236,16 +273,23 @@ public:
 
     /**
      * @brief builds the move data structure mds using the construction method v1
+     * @param I disjoint interval sequence
      */
-    void v1()
+    template <typename pair_arr_in_t>
+    void v1(pair_arr_in_t& I)
     {
+        T_in_v1 = tin_t_v1(&arenas[0]);
+        T_out_v1 = tout_te_t_v1(&arenas[0]);
+        T_e_v1 = tout_te_t_v1(&arenas[0]);
+
         // Build T_in_v1 and T_out_v1
-        build_tin_tout_v1();
+        build_tin_tout_v1(I);
 
         balance_v1_seq();
 
         // Build D_p and D_q
         build_dp_dq_v1();
+        release_arenas();
 
         // Build D_offs and D_idx
         build_didx_doffs_v1();
@@ -253,8 +297,10 @@ public:
 
     /**
      * @brief builds T_in_v1 and T_out_v1
+     * @param I disjoint interval sequence
      */
-    void build_tin_tout_v1();
+    template <typename pair_arr_in_t>
+    void build_tin_tout_v1(pair_arr_in_t& I);
 
     /**
      * @brief balances the disjoint interval sequence stored in T_in_v1 and T_out_v1
@@ -311,21 +357,24 @@ public:
 
     /**
      * @brief builds the move data structure mds using the construction method v2, v3 or v4
+     * @param I disjoint interval sequence
      */
-    void v2v3v4()
+    template <typename pair_arr_in_t>
+    void v2v3v4(pair_arr_in_t& I)
     {
         // Build L_in_v2v3v4 and T_out_v2v3v4
-        build_lin_tout_v2v3v4();
+        build_lin_tout_v2v3v4(I);
 
         // Choose the correct balancing algorithm
         if (p == 1) {
-            if constexpr (v == 2) {
+            if (v == 2) {
+                T_e_v2 = te_t_v2(&arenas[0]);
                 balance_v2_seq();
             } else {
                 balance_v3_seq();
             }
         } else {
-            if constexpr (v == 3) {
+            if (v == 3) {
                 balance_v3_par();
             } else {
                 balance_v4_par();
@@ -334,6 +383,7 @@ public:
 
         // Build D_p and D_q
         build_dp_dq_v2v3v4();
+        release_arenas();
 
         // Build D_offs and D_idx
         build_didx_doffs_v2v3v4v5();
@@ -341,8 +391,10 @@ public:
 
     /**
      * @brief builds L_in_v2v3v4[0..p-1] and T_out_v2v3v4[0..p-1] out of the disjoint interval sequence I
+     * @param I disjoint interval sequence
      */
-    void build_lin_tout_v2v3v4();
+    template <typename pair_arr_in_t>
+    void build_lin_tout_v2v3v4(pair_arr_in_t& I);
 
     /**
      * @brief inserts the pairs in L_in_v2v3v4[0..p-1] into D_pair and writes D_idx
@@ -513,8 +565,8 @@ public:
 
     // ############################# V5 SEQUENTIAL/PARALLEL #############################
 
-    using tin_t_v5 = gtl::btree_set<pair_t, in_cmp_v1v5>;
-    using tout_t_v5 = gtl::btree_set<pair_t, out_cmp_v1v5>;
+    using tin_t_v5 = gtl::btree_set<pair_t, in_cmp_v1v5, arena_allocator<pair_t>>;
+    using tout_t_v5 = gtl::btree_set<pair_t, out_cmp_v1v5, arena_allocator<pair_t>>;
 
     using tin_it_t_v5 = typename tin_t_v5::iterator;
     using tout_it_t_v5 = typename tout_t_v5::iterator;
@@ -556,17 +608,20 @@ public:
 
     /**
      * @brief builds the move data structure mds using the construction method v5
+     * @param I disjoint interval sequence
      */
-    void v5()
+    template <typename pair_arr_in_t>
+    void v5(pair_arr_in_t& I)
     {
         // build T_in_v5 and T_out_v5
-        build_tin_tout_v5();
+        build_tin_tout_v5(I);
 
         // balance the disjoint interval sequence stored in T_in_v5 and T_out_v5
         balance_v5_seq_par();
 
         // Build D_p and D_q
         build_dp_dq_v5();
+        release_arenas();
 
         // Build D_offs and D_idx
         build_didx_doffs_v2v3v4v5();
@@ -574,8 +629,10 @@ public:
 
     /**
      * @brief builds T_in_v5 and T_out_v5
+     * @param I disjoint interval sequence
      */
-    void build_tin_tout_v5();
+    template <typename pair_arr_in_t>
+    void build_tin_tout_v5(pair_arr_in_t& I);
 
     /**
      * @brief builds D_p and D_q
@@ -612,12 +669,74 @@ public:
      * @brief balances the disjoint interval sequence in L_in_v5[0..p-1] and T_out_v5[0..p-1] sequentially or in parallel
      */
     void balance_v5_seq_par();
+
+    // ############################# V6 PARALLEL #############################
+
+    /**
+     * @brief stores the pairs (p_i,q_i) in ascending order of p_i
+     */
+    pair_arr_t P_in_v6;
+
+    /**
+     * @brief stores the pairs (p_i,q_i) in ascending order of q_i
+     */
+    pair_arr_t P_out_v6;
+
+    /**
+     * @brief builds the move data structure mds using the construction method v6
+     * @param I disjoint interval sequence
+     */
+    template <typename pair_arr_in_t>
+    void v6(pair_arr_in_t& I)
+    {
+        // build P_in_v6 and P_out_v6
+        build_pin_pout_v6(I);
+
+        // balance the disjoint interval sequence stored in P_in_v6 and P_out_v6
+        balance_v6_par();
+
+        // Build D_p and D_q
+        build_dp_dq_v6();
+
+        // Build D_offs and D_idx
+        build_didx_doffs_v2v3v4v5();
+    }
+
+    /**
+     * @brief builds P_in_v6 and P_out_v6 out of I and splits the too long input intervals
+     * @param I disjoint interval sequence
+     */
+    template <typename pair_arr_in_t>
+    void build_pin_pout_v6(pair_arr_in_t& I);
+
+    /**
+     * @brief builds D_p and D_q
+     */
+    void build_dp_dq_v6();
+
+    /**
+     * @brief merges the pairs in N, which must not share a key with a pair in P, into P in parallel;
+     *        P and N must both be sorted by key(pr)
+     * @param P pair array sorted by key(pr)
+     * @param N pair array sorted by key(pr)
+     * @param key returns the key of a pair
+     */
+    template <typename key_t>
+    void merge_v6(pair_arr_t& P, pair_arr_t& N, key_t key);
+
+    /**
+     * @brief balances the disjoint interval sequence in P_in_v6 and P_out_v6 in rounds; in each round, all a-heavy
+     *        output intervals are found with a merge-style scan over P_in_v6 and P_out_v6 and split, and the newly
+     *        created pairs are merged into P_in_v6 and P_out_v6; this is repeated until no a-heavy output interval is left
+     */
+    void balance_v6_par();
 };
 
 #include "algorithms/construction/v1.cpp"
 #include "algorithms/construction/v1v2v3v4v5.cpp"
 #include "algorithms/construction/v2v3v4.cpp"
 #include "algorithms/construction/v5.cpp"
+#include "algorithms/construction/v6.cpp"
 
 #include "algorithms/balancing/v1_seq.cpp"
 #include "algorithms/balancing/v2_seq.cpp"
@@ -625,5 +744,6 @@ public:
 #include "algorithms/balancing/v3_seq.cpp"
 #include "algorithms/balancing/v4_par.cpp"
 #include "algorithms/balancing/v5_seq_par.cpp"
+#include "algorithms/balancing/v6_par.cpp"
 
 #include "algorithms/misc/verify_correctness.cpp"
\ No newline at end of file
@@ -10,6 +10,11 @@ struct mds_params {
     uint16_t a = 8; // balancing parameter, restricts the number of intervals in the resulting move data structure to k*(a/(a-1))
     bool log = false; // controls whether to print log messages during the construction
     std::ostream* mf = NULL; // measurement file to write runtime data to
+    /* construction method in [1..6] (other values are rejected); 5 balances with b-trees, 6 with sorted arrays and merge-style
+     * passes; if p > 1 and 1000*p > k, then 3, 4 and 5 are replaced by 6 (and this is logged), since their p static sections
+     * would contain too few intervals */
+    uint8_t version = 5;
+    bool huge_pages = false; // controls whether the arenas storing the tree and list nodes during the construction are backed by huge pages
 };
 
 /**
@@ -25,6 +30,8 @@ protected:
 
     using pair_t = std::pair<pos_t, pos_t>; // pair type
     using pair_arr_t = std::vector<pair_t>; // pair array type
+    using packed_pair_t = std::pair<packed_t<pos_t>, packed_t<pos_t>>; // packed pair type (see packed_t)
+    using packed_pair_arr_t = std::vector<packed_pair_t>; // packed pair array type
 
     pos_t n = 0; // n = p_{k_'-1} + d_{k_'-1}, k_' <= n
     pos_t k = 0; // k, number of intervals in the original disjoint inteval sequence I
@@ -50,7 +57,7 @@ public:
      * @param params construction parameters
      * @param pi_mphi vector to move pi into after the construction
      */
-    move_data_structure(pair_arr_t&& I, pos_t n, mds_params params = {}, std::vector<pos_t>* pi_mphi = NULL)
+    move_data_structure(pair_arr_t&& I, pos_t n, mds_params params = {}, std::vector<packed_t<pos_t>>* pi_mphi = NULL)
     {
         construction(*this, I, n, true, 0, params, pi_mphi);
     }
@@ -62,7 +69,35 @@ public:
      * @param params construction parameters
      * @param pi_mphi vector to move pi into after the construction
      */
-    move_data_structure(pair_arr_t& I, pos_t n, mds_params params = {}, std::vector<pos_t>* pi_mphi = NULL)
+    move_data_structure(pair_arr_t& I, pos_t n, mds_params params = {}, std::vector<packed_t<pos_t>>* pi_mphi = NULL)
+    {
+        construction(*this, I, n, false, 0, params, pi_mphi);
+    }
+
+    /**
+     * @brief Constructs a new move data structure from a disjoint interval sequence of 40-bit packed pairs (only for
+     * pos_t = uint64_t), which takes 10 instead of 16 bytes per interval; n must be less than 2^40
+     * @param I a disjoint interval sequence
+     * @param n n = p_k + d_j
+     * @param params construction parameters
+     * @param pi_mphi vector to move pi into after the construction
+     */
+    move_data_structure(packed_pair_arr_t&& I, pos_t n, mds_params params = {}, std::vector<packed_t<pos_t>>* pi_mphi = NULL)
+        requires(std::is_same_v<pos_t, uint64_t>)
+    {
+        construction(*this, I, n, true, 0, params, pi_mphi);
+    }
+
+    /**
+     * @brief Constructs a new move data structure from a disjoint interval sequence of 40-bit packed pairs (only for
+     * pos_t = uint64_t), which takes 10 instead of 16 bytes per interval; n must be less than 2^40
+     * @param I a disjoint interval sequence
+     * @param n n = p_k + d_j
+     * @param params construction parameters
+     * @param pi_mphi vector to move pi into after the construction
+     */
+    move_data_structure(packed_pair_arr_t& I, pos_t n, mds_params params = {}, std::vector<packed_t<pos_t>>* pi_mphi = NULL)
+        requires(std::is_same_v<pos_t, uint64_t>)
     {
         construction(*this, I, n, false, 0, params, pi_mphi);
     }
@@ -12,15 +12,18 @@ class move_data_structure_l_ : public move_data_structure<pos_t> {
 
     using pair_t = typename move_data_structure<pos_t>::pair_t; // pair type
     using pair_arr_t = typename move_data_structure<pos_t>::pair_arr_t; // pair array type
+    using packed_pair_arr_t = typename move_data_structure<pos_t>::packed_pair_arr_t; // packed pair array type
 
     /**
      * @brief Constructs a new move data structure from a disjoint interval sequence
+     * @tparam pair_arr_in_t type of the disjoint interval sequence (pair_arr_t or packed_pair_arr_t)
      * @param I a disjoint interval sequence
      * @param n n = p_k + d_j
      * @param delete_i whether I can be deleted during the construction
      * @param params construction parameters
      */
-    void build(pair_arr_t& I, pos_t n, bool delete_i, mds_params params, uint8_t omega_l_)
+    template <typename pair_arr_in_t>
+    void build(pair_arr_in_t& I, pos_t n, bool delete_i, mds_params params, uint8_t omega_l_)
     {
         typename move_data_structure<pos_t>::construction(
             *reinterpret_cast<move_data_structure<pos_t>*>(this), I, n, delete_i, omega_l_, params, NULL);
@@ -52,6 +55,32 @@ public:
         build(I, n, false, params, omega_l_);
     }
 
+    /**
+     * @brief Constructs a new move data structure from a disjoint interval sequence of 40-bit packed pairs (only for
+     * pos_t = uint64_t); n must be less than 2^40
+     * @param I a disjoint interval sequence
+     * @param n n = p_k + d_j
+     * @param params construction parameters
+     */
+    move_data_structure_l_(packed_pair_arr_t&& I, pos_t n, mds_params params = {}, uint8_t omega_l_ = sizeof(l_t))
+        requires(std::is_same_v<pos_t, uint64_t>)
+    {
+        build(I, n, true, params, omega_l_);
+    }
+
+    /**
+     * @brief Constructs a new move data structure from a disjoint interval sequence of 40-bit packed pairs (only for
+     * pos_t = uint64_t); n must be less than 2^40
+     * @param I a disjoint interval sequence
+     * @param n n = p_k + d_j
+     * @param params construction parameters
+     */
+    move_data_structure_l_(packed_pair_arr_t& I, pos_t n, mds_params params = {}, uint8_t omega_l_ = sizeof(l_t))
+        requires(std::is_same_v<pos_t, uint64_t>)
+    {
+        build(I, n, false, params, omega_l_);
+    }
+
     /**
      * @brief returns the number omega_l_ of bits used by one entry in L' (word width of L')
      * @return omega_l_
@@ -109,16 +109,28 @@ protected:
 
     /**
      * @brief builds the bit vectors
+     * @tparam read_t type of read
      * @param read function to read the input with; it is called with i in [l,r]
      * as a parameter and must return the value of the input at index i
      * @param l left range limit (l <= r)
      * @param r right range limit (l <= r)
+     * @param p number of threads to use
      */
-    void build(const std::function<sym_t(pos_t)>& read, pos_t l, pos_t r)
+    template <typename read_t>
+    void build(const read_t& read, pos_t l, pos_t r, uint16_t p = 1)
     {
         input_size = r - l + 1;
         uint8_t bytes_per_entry = 0;
         pos_t alphabet_range = byte_alphabet ? 256 : sigma;
+
+        // each thread counts the frequencies in its section separately, so use at most input_size / alphabet_range threads
+        p = std::max<uint64_t>(1, std::min<uint64_t>(p, input_size / std::max<pos_t>(1, alphabet_range)));
+
+        if (p > 1) {
+            build_parallel(read, l, r, p);
+            return;
+        }
+
         freq.resize(alphabet_range, 0);
 
         for (pos_t i = l; i <= r; i++) {
@@ -249,6 +261,226 @@ protected:
         }
     }
 
+    /**
+     * @brief builds the bit vectors in parallel; the input is split into p sections, whose starting positions
+     * are multiples of 64, s.t. no two threads write to the same word of a plain bit vector
+     * @tparam read_t type of read
+     * @param read function to read the input with; it is called concurrently with i in [l,r]
+     * as a parameter and must return the value of the input at index i
+     * @param l left range limit (l <= r)
+     * @param r right range limit (l <= r)
+     * @param p number of threads to use (p > 1)
+     */
+    template <typename read_t>
+    void build_parallel(const read_t& read, pos_t l, pos_t r, uint16_t p)
+    {
+        uint8_t bytes_per_entry = 0;
+        pos_t alphabet_range = byte_alphabet ? 256 : sigma;
+
+        // [0..p], thread i_p processes the input positions in [l+s_p[i_p]..l+s_p[i_p+1]-1]
+        std::vector<pos_t> s_p(p + 1);
+        uint64_t sec_len = ((input_size / p) / 64 + 1) * 64;
+
+        for (uint16_t i_p = 0; i_p <= p; i_p++) {
+            s_p[i_p] = std::min<uint64_t>(input_size, i_p * sec_len);
+        }
+
+        /* [0..p-1][0..alphabet_range-1], freq_p[i_p][v] = frequency of v in thread i_p's section; after computing
+           the prefix sums, it is the position, where thread i_p stores its next occurrence of v */
+        std::vector<std::vector<pos_t>> freq_p(p);
+
+        #pragma omp parallel num_threads(p)
+        {
+            uint16_t i_p = omp_get_thread_num();
+            freq_p[i_p].resize(alphabet_range, 0);
+
+            for (pos_t i = l + s_p[i_p]; i < l + s_p[i_p + 1]; i++) {
+                freq_p[i_p][symbol_idx(read(i))]++;
+            }
+        }
+
+        no_init_resize(freq, alphabet_range);
+
+        #pragma omp parallel for num_threads(p)
+        for (uint64_t v = 0; v < alphabet_range; v++) {
+            pos_t freq_v = 0;
+
+            for (uint16_t i_p = 0; i_p < p; i_p++) {
+                freq_v += freq_p[i_p][v];
+            }
+
+            freq[v] = freq_v;
+        }
+
+        if constexpr (int_alphabet) {
+            bytes_per_entry = (uint8_t)std::ceil(std::log2(input_size + 1) / (double)8);
+            c_arr = interleaved_vectors<pos_t, pos_t>({ bytes_per_entry });
+            c_arr.resize_no_init(alphabet_range + 1);
+            c_arr.template set<0, pos_t>(0, 0);
+        }
+
+#ifndef BENCH_RANK_SELECT
+        pos_t max_occ_plain = build_select_support ? input_size * thrsh_plain_select : min_occ_vec;
+#else
+        pos_t max_occ_plain = std::numeric_limits<pos_t>::max();
+        max_occ_lookup_select = input_size * thrsh_plain_select;
+#endif
+
+        if constexpr (byte_alphabet) {
+            for (pos_t v = 0; v < 256; v++) {
+                if (freq[v] != 0) {
+                    sigma++;
+                }
+            }
+        } else {
+            for (pos_t v = 0; v < alphabet_range; v++) {
+                if (freq[v] <= max_occ_plain) {
+                    c_arr.template set<0, pos_t>(v + 1, c_arr[v] + freq[v]);
+                } else {
+                    c_arr.template set<0, pos_t>(v + 1, c_arr[v]);
+                }
+            }
+        }
+
+        std::vector<sdsl::bit_vector> plain_bvs;
+        pos_t max_occ_sd_array = input_size * thrsh_sd_array;
+        num_vectors = byte_alphabet ? 256 : 0;
+        pos_t min_occ_vec_tmp = 0;
+
+        /* the positions of the symbols, whose bit vectors are sd_vectors, must be passed to the sd_vector_builders in
+           ascending order, hence they are first scattered into sd_occs (or into occs) and the sd_vectors are built afterwards */
+        std::vector<pos_t> sd_occs;
+        // [0..alphabet_range-1], sd_c[v] = position of the first occurrence of v in sd_occs
+        std::vector<pos_t> sd_c;
+        no_init_resize(sd_c, alphabet_range);
+        pos_t num_sd_occs = 0;
+
+        if constexpr (int_alphabet) {
+            min_occ_vec_tmp = std::min<pos_t>(min_occ_vec, max_occ_plain);
+            vec_idx = interleaved_vectors<pos_t, pos_t>({ (uint8_t)std::ceil(std::log2(sigma + 1) / (double)8) });
+            vec_idx.resize_no_init(sigma);
+        } else {
+            plain_bvs.resize(256);
+        }
+
+        for (pos_t v = 0; v < alphabet_range; v++) {
+            if constexpr (int_alphabet) {
+                if (freq[v] > min_occ_vec_tmp) {
+                    if (freq[v] <= max_occ_sd_array) {
+                        plain_bvs.emplace_back(sdsl::bit_vector());
+
+                        if (freq[v] > max_occ_plain) {
+                            sd_c[v] = num_sd_occs;
+                            num_sd_occs += freq[v];
+                        }
+                    } else {
+                        plain_bvs.emplace_back(sdsl::bit_vector(input_size));
+                    }
+
+                    vec_idx.template set<0, pos_t>(v, num_vectors);
+                    num_vectors++;
+                } else {
+                    vec_idx.template set<0, pos_t>(v, sigma);
+                }
+            } else {
+                if (freq[v] != 0) {
+                    if (freq[v] <= max_occ_sd_array) {
+                        sd_c[v] = num_sd_occs;
+                        num_sd_occs += freq[v];
+                    } else {
+                        plain_bvs[v] = sdsl::bit_vector(input_size);
+                    }
+                }
+            }
+        }
+
+        if constexpr (int_alphabet) {
+            occs = interleaved_vectors<pos_t, pos_t>({ bytes_per_entry });
+            occs.resize_no_init(c_arr[alphabet_range]);
+        }
+
+        no_init_resize(sd_occs, num_sd_occs);
+
+        #pragma omp parallel for num_threads(p)
+        for (uint64_t v = 0; v < alphabet_range; v++) {
+            pos_t pos = int_alphabet && freq[v] <= max_occ_plain ? c_arr[v] : sd_c[v];
+
+            for (uint16_t i_p = 0; i_p < p; i_p++) {
+                pos_t freq_p_v = freq_p[i_p][v];
+                freq_p[i_p][v] = pos;
+                pos += freq_p_v;
+            }
+        }
+
+        #pragma omp parallel num_threads(p)
+        {
+            uint16_t i_p = omp_get_thread_num();
+            std::vector<pos_t>& pos = freq_p[i_p];
+
+            for (pos_t i = l + s_p[i_p]; i < l + s_p[i_p + 1]; i++) {
+                pos_t v = symbol_idx(read(i));
+
+                if constexpr (int_alphabet) {
+                    if (freq[v] <= max_occ_plain) {
+                        occs.template set<0, pos_t>(pos[v], i - l);
+                        pos[v]++;
+                    } else if (freq[v] <= max_occ_sd_array) {
+                        sd_occs[pos[v]] = i - l;
+                        pos[v]++;
+                    }
+
+                    if (freq[v] > min_occ_vec_tmp && freq[v] > max_occ_sd_array) {
+                        plain_bvs[vec_idx[v]][i - l] = 1;
+                    }
+                } else {
+                    if (freq[v] <= max_occ_sd_array) {
+                        sd_occs[pos[v]] = i - l;
+                        pos[v]++;
+                    } else {
+                        plain_bvs[v][i - l] = 1;
+                    }
+                }
+            }
+
+            pos.clear();
+            pos.shrink_to_fit();
+        }
+
+        hyb_bit_vecs.resize(num_vectors);
+
+        #pragma omp parallel for num_threads(p) schedule(dynamic)
+        for (uint64_t v = 0; v < alphabet_range; v++) {
+            if (int_alphabet ? freq[v] <= min_occ_vec_tmp : freq[v] == 0) {
+                continue;
+            }
+
+            pos_t vec = int_alphabet ? vec_idx[v] : v;
+
+            if (freq[v] > max_occ_sd_array) {
+                hyb_bit_vecs[vec] = hybrid_bv_t(std::move(plain_bvs[vec]));
+            } else {
+                sdsl::sd_vector_builder sdv_builder(input_size, freq[v]);
+
+                if (int_alphabet && freq[v] <= max_occ_plain) {
+                    for (pos_t j = c_arr[v]; j < c_arr[v + 1]; j++) {
+                        sdv_builder.set(occs[j]);
+                    }
+                } else {
+                    for (pos_t j = sd_c[v]; j < sd_c[v] + freq[v]; j++) {
+                        sdv_builder.set(sd_occs[j]);
+                    }
+                }
+
+                hyb_bit_vecs[vec] = hybrid_bv_t(sdsl::sd_vector<>(sdv_builder));
+            }
+        }
+
+        if constexpr (int_alphabet) {
+            freq.clear();
+            freq.shrink_to_fit();
+        }
+    }
+
 public:
     rank_select_support() = default;
 
@@ -284,6 +516,22 @@ public:
         build(read, l, r);
     }
 
+    /**
+     * @brief builds the data structure in parallel by reading the input using the function read
+     * @tparam read_t type of read
+     * @param read function to read the input with; it is called concurrently with i in [l,r]
+     * as a parameter and must return the value of the input at index i
+     * @param l left range limit (l <= r)
+     * @param r right range limit (l <= r)
+     * @param p number of threads to use
+     */
+    template <typename read_t>
+    rank_select_support(const read_t& read, pos_t l, pos_t r, uint16_t p)
+        requires(byte_alphabet)
+    {
+        build(read, l, r, p);
+    }
+
     /**
      * @brief builds the data structure from the range [l,r] in input (0 <= l <= r < input.size()),
      * else if l > r, then the the data structure is built for the whole input
@@ -322,6 +570,25 @@ public:
         build(read, l, r);
     }
 
+    /**
+     * @brief builds the data structure in parallel by reading the input using the function read
+     * @tparam read_t type of read
+     * @param read function to read the input with; it is called concurrently with i in [l,r]
+     * as a parameter and must return the value of the input at index i
+     * @param alphabet_size maximum value in the input + 1 (should also be the number of distinct
+     * values in the input)
+     * @param l left range limit (l <= r)
+     * @param r right range limit (l <= r)
+     * @param p number of threads to use
+     */
+    template <typename read_t>
+    rank_select_support(const read_t& read, pos_t alphabet_size, pos_t l, pos_t r, uint16_t p)
+        requires(int_alphabet)
+    {
+        sigma = alphabet_size;
+        build(read, l, r, p);
+    }
+
     /**
      * @brief returns the size of the input
      * @return the size of the input
@@ -3,14 +3,20 @@
 #include <algorithm>
 #include <chrono>
 #include <climits>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <random>
 #include <string>
 #include <unistd.h>
 #include <vector>
 
+#ifdef MOVE_R_MALLOC_COUNT
 #include <malloc_count.h>
+#else
+#include <sys/resource.h>
+#endif
 
 uint64_t ram_size()
 {
@@ -19,6 +25,68 @@ uint64_t ram_size()
     return pages * page_size;
 }
 
+/* Memory accounting: if move-r is linked with malloc_count (CMake target move_r_malloc_count, which defines
+   MOVE_R_MALLOC_COUNT), the memory usage is the number of bytes allocated on the heap; otherwise, no allocator is
+   interposed, and the memory usage is the resident set size of the process, as reported by /proc (or getrusage). */
+
+#ifndef MOVE_R_MALLOC_COUNT
+/**
+ * @brief returns the value of a field of /proc/self/status in bytes
+ * @param field name of the field (e.g. "VmRSS:")
+ * @return value of the field in bytes (0, if it does not exist)
+ */
+uint64_t proc_status_bytes(std::string field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return std::stoull(line.substr(field.size())) * 1024;
+        }
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief returns the current memory usage of the process in bytes
+ * @return current memory usage in bytes
+ */
+uint64_t current_memory_usage()
+{
+#ifdef MOVE_R_MALLOC_COUNT
+    return malloc_count_current();
+#else
+    return proc_status_bytes("VmRSS:");
+#endif
+}
+
+/**
+ * @brief returns the peak memory usage of the process in bytes (since the start of the process, or with malloc_count
+ * since the last call to malloc_count_reset_peak()); it is never reset here, since that would also affect the
+ * measurements of the rest of the process, so the peak of a part of the program must be computed relative to the
+ * current and the peak memory usage before it
+ * @return peak memory usage in bytes
+ */
+uint64_t peak_memory_usage()
+{
+#ifdef MOVE_R_MALLOC_COUNT
+    return malloc_count_peak();
+#else
+    uint64_t peak = proc_status_bytes("VmHWM:");
+
+    if (peak == 0) {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = usage.ru_maxrss * 1024;
+    }
+
+    return peak;
+#endif
+}
+
 std::chrono::steady_clock::time_point now()
 {
     return std::chrono::steady_clock::now();
@@ -222,13 +290,16 @@ bool is_subset_of(std::vector<T> first, std::vector<T> second)
 
 std::string random_alphanumeric_string(uint64_t length)
 {
-    static std::string possible_chars = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    static const std::string possible_chars = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    // every thread has its own (randomly seeded) generator, s.t. concurrent calls neither interfere nor return equal strings
+    thread_local std::mt19937_64 gen(std::random_device {}());
+    std::uniform_int_distribution<uint64_t> distrib(0, possible_chars.size() - 1);
 
     std::string str_rand;
     str_rand.reserve(length);
 
     for (uint64_t i = 0; i < length; i++) {
-        str_rand.push_back(possible_chars[std::rand() % possible_chars.size()]);
+        str_rand.push_back(possible_chars[distrib(gen)]);
     }
 
     return str_rand;
@@ -245,9 +316,49 @@ std::string to_string(std::pair<pos_t, pos_t> pair)
     return str;
 }
 
+/**
+ * @brief unsigned 40-bit integer that is stored in 5 bytes (without padding), s.t. arrays of values in [0, 2^40) take
+ * 5 instead of 8 bytes per entry; it converts implicitly to uint64_t, but only explicitly from uint64_t (assignments
+ * from uint64_t are implicit), s.t. it can be mixed with 64-bit integers in expressions
+ */
+class uint40_t {
+    uint8_t bytes[5];
+
+public:
+    static constexpr uint64_t max = (uint64_t { 1 } << 40) - 1; // maximum value
+
+    uint40_t() = default;
+
+    explicit uint40_t(uint64_t value) noexcept
+    {
+        *this = value;
+    }
+
+    inline uint40_t& operator=(uint64_t value) noexcept
+    {
+        std::memcpy(bytes, &value, 5);
+        return *this;
+    }
+
+    inline operator uint64_t() const noexcept
+    {
+        uint64_t value = 0;
+        std::memcpy(&value, bytes, 5);
+        return value;
+    }
+};
+
+/**
+ * @brief packed type of the intermediate arrays of positions in the constructions; for pos_t = uint64_t, the
+ * positions are packed to 40 bits (so these arrays can only store values in [0, 2^40))
+ * @tparam pos_t unsigned integer type
+ */
+template <typename pos_t>
+using packed_t = std::conditional_t<std::is_same_v<pos_t, uint64_t>, uint40_t, pos_t>;
+
 template <typename T>
 class no_init {
-    static_assert(std::is_fundamental<T>::value);
+    static_assert(std::is_fundamental<T>::value || std::is_same_v<T, uint40_t>);
 
 private:
     T v_;
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <atomic>
+#include <exception>
+#include <filesystem>
 #include <iostream>
+#include <limits>
 #include <move_r/data_structures/interleaved_vectors.hpp>
 #include <move_r/data_structures/move_data_structure/move_data_structure.hpp>
 #include <move_r/data_structures/move_data_structure/move_data_structure_l_.hpp>
 #include <move_r/data_structures/rank_select_support.hpp>
 #include <move_r/misc/utils.hpp>
+#include <numeric>
 #include <omp.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
 #include <tsl/sparse_map.h>
 #include <type_traits>
 
@@ -17,14 +27,18 @@ enum move_r_support {
     _count, // only count support (no locate support)
     _locate_one, // support for computing exaclty one occurrence per pattern
     _locate_move, // locate support is implemented using a move data structure to answer Phi^{-1}-queries
-    _locate_rlzdsa // locate support is implemented by relative lepel-ziv encoding the differential suffix array
+    _locate_rlzdsa, // locate support is implemented by relative lepel-ziv encoding the differential suffix array
+    /* both M_Phi^{-1} and the rlzdsa are stored; for each query, the occurrences are decoded with the rlzdsa
+       if there are at least min_occ_rlzdsa many, else with M_Phi^{-1} */
+    _locate_hybrid
 };
 
 /**
  * @brief move-r construction mode
  */
 enum move_r_construction_mode {
-    _bigbwt, // builds the bwt with Big-BWT and stores many data structures on disk to reduce peak memory usage
+    _pfp, // builds the bwt with prefix-free parsing and stores many data structures on disk to reduce peak memory usage
+    _bigbwt = _pfp, // alias of _pfp (prefix-free parsing used to be done by the external Big-BWT executable)
     _suffix_array, // builds the suffix array in-memory and stores no data structures on disk
     _suffix_array_space // builds the suffix array and stores some data structures on disk
 };
@@ -44,11 +58,85 @@ struct move_r_params {
     std::ostream* mf_idx = NULL; // measurement file for the index construciton
     std::ostream* mf_mds = NULL; // measurement file for the move data structure construction
     std::string name_text_file = ""; // name of the input file (used only for measurement output)
+    uint64_t seed = 0; // seed for the random number generators used during the construction (e.g. for choosing R in the rlzdsa)
+    /* file storing a reference for the rlzdsa that has been written with move_r::export_reference() (only for support =
+       _locate_rlzdsa or _locate_hybrid); if set, R is not built, but the rlzdsa is computed relative to the reference stored in this file */
+    std::string path_reference = "";
+    bool embed_reference = true; // controls, whether R is stored in the index or whether only path_reference is stored
+    uint16_t sr_scp = 4; // sample rate of the copy phrases in the rlzdsa, 1 <= sr_scp
+    // maximum distance to scan over L' to find the first and last occurrences of a symbol (only for byte alphabets)
+    uint16_t max_scan_l_ = 128;
+    /* controls, whether to calibrate the minimum number of occurrences to use the rlzdsa with a micro-benchmark (only for
+       support = _locate_hybrid); the calibration measures query times, so its result may differ between constructions;
+       else, the minimum number of occurrences is estimated from n and r' */
+    bool calibrate_min_occ = false;
+    /* memory budget for the construction in bytes; if set (!= 0), mode is ignored, and the construction mode and the number
+       of threads are chosen s.t. the estimated peak memory usage does not exceed the budget (0 <=> no budget) */
+    uint64_t max_memory = 0;
+    /* directory to write checkpoints to; after each expensive phase (the suffix array or the BWT, and the reference of the
+       rlzdsa), its outputs are written to this directory and recorded in a manifest (empty <=> no checkpoints) */
+    std::string checkpoint_dir = "";
+    bool resume = false; // controls, whether to skip the phases completed in the checkpoint in checkpoint_dir (after validating them)
+    bool keep_checkpoint = false; // controls, whether to keep the checkpoint after the construction has finished
+    /* directory in which each construction creates its own directory for its temporary files, which is removed after the
+       construction (empty <=> the system's temporary directory) */
+    std::string tmp_dir = "";
 };
 
+/**
+ * @brief move-r auto-tuning parameters
+ */
+struct move_r_tuning_params {
+    std::vector<uint16_t> a = { 2, 4, 8, 16, 32 }; // candidates for the balancing parameter
+    std::vector<uint16_t> sr_scp = { 1, 2, 4, 8, 16, 32 }; // candidates for the sample rate of the copy phrases in the rlzdsa
+    std::vector<uint16_t> max_scan_l_ = { 16, 32, 64, 128, 256, 512 }; // candidates for the maximum scan distance over L'
+    uint64_t max_size_in_bytes = std::numeric_limits<uint64_t>::max(); // memory budget for the index
+    uint8_t num_repetitions = 3; // number of times the sample patterns are queried per candidate
+};
+
+/* serialized indexes and reference files start with a magic number followed by a format version; indexes without
+   them have been written before the format was versioned and are read as version 0 */
+constexpr uint64_t move_r_index_magic = 0x7864692d722d766d; // "mv-r-idx"
+constexpr uint64_t move_r_reference_magic = 0x6665722d722d766d; // "mv-r-ref"
+constexpr uint16_t move_r_index_format_version = 1; // version 1 adds max_scan_l_, sr_scp, n_R and shared references
+constexpr uint16_t move_r_reference_format_version = 1;
+
+/**
+ * @brief reads the position type and the support of a serialized index from an input stream; afterwards, the stream is
+ * at the same position as before
+ * @param in an input stream storing a serialized index
+ * @return (is_64_bit, support), where is_64_bit is true <=> the index uses 64-bit positions
+ */
+inline std::pair<bool, move_r_support> read_index_type(std::istream& in)
+{
+    std::streampos pos_start = in.tellg();
+    uint64_t magic = 0;
+    uint16_t version = 0;
+    in.read((char*)&magic, sizeof(uint64_t));
+
+    if (in.good() && magic == move_r_index_magic) {
+        in.read((char*)&version, sizeof(uint16_t));
+    } else {
+        in.clear();
+        in.seekg(pos_start, std::ios::beg);
+    }
+
+    uint8_t is_64_bit = 0;
+    move_r_support support = _count;
+    in.read((char*)&is_64_bit, 1);
+    in.read((char*)&support, sizeof(move_r_support));
+
+    if (!in.good() || is_64_bit > 1 || support > _locate_hybrid) {
+        throw std::runtime_error("the input stream does not store a move-r index");
+    }
+
+    in.seekg(pos_start, std::ios::beg);
+    return { is_64_bit == 1, support };
+}
+
 /**
  * @brief move-r index, size O(r*(a/(a-1)))
- * @tparam support type of locate support (_locate_move or _locate_rlzdsa)
+ * @tparam support type of locate support (_locate_move, _locate_rlzdsa or _locate_hybrid)
  * @tparam sym_t value type (default: char for strings)
  * @tparam pos_t index integer type (use uint32_t if input size < UINT_MAX, else uint64_t)
  */
@@ -82,6 +170,8 @@ protected:
     static constexpr bool supports_locate = support != _count; // true <=> the index supports locate
     // true <=> the index supports locating multiple occurrences
     static constexpr bool supports_multiple_locate = supports_locate && support != _locate_one;
+    static constexpr bool has_m_phi_m1 = support == _locate_move || support == _locate_hybrid; // true <=> M_Phi^{-1} is stored
+    static constexpr bool has_rlzdsa = support == _locate_rlzdsa || support == _locate_hybrid; // true <=> the rlzdsa is stored
     static constexpr bool str_input = std::is_same_v<sym_t, char>; // true <=> the input is a string
     static constexpr bool int_input = !str_input; // true <=> the input is an iteger vector
     static constexpr bool byte_alphabet = sizeof(sym_t) == 1; // true <=> the input uses a byte alphabet
@@ -92,12 +182,6 @@ protected:
     using inp_t = std::conditional_t<str_input, std::string, std::vector<sym_t>>; // input container type
     using rsl_t = rank_select_support<i_sym_t, pos_t, true, true>; // type of RS_L'
 
-    // sample rate of the copy phrases in the rlzdsa
-    static constexpr pos_t sr_scp = 4;
-
-    // maximum distance to scan over L' to find the first and last occurrences of sym in L'[\hat{b},\hat{e}]
-    static constexpr pos_t max_scan_l_ = 128;
-
     // ############################# INDEX VARIABLES #############################
 
     pos_t n = 0; // the length of the input
@@ -108,14 +192,21 @@ protected:
     pos_t z = 0; // z, the number of phrases in the rlzdsa
     pos_t z_l = 0; // z_l, the number of literal phrases in the rlzdsa
     pos_t z_c = 0; // z_c, the number of copy-phrases in the rlzdsa
+    pos_t n_R = 0; // the length of the input the reference (R) of the rlzdsa has been built for; R stores SA^d[i]+n_R
     uint16_t a = 0; // balancing parameter, restricts size to O(r*(a/(a-1))+z), 2 <= a
     uint16_t p_r = 1; // maximum possible number of threads to use while reverting the index
+    uint8_t k_lf = 1; // k, the number of LF-steps per move query with M_LF^k (1 <=> M_LF^k is not built)
     uint8_t omega_idx = 0; // word width of SA_Phi^{-1}
+    pos_t sr_scp = 4; // sample rate of the copy phrases in the rlzdsa
+    // maximum distance to scan over L' to find the first and last occurrences of sym in L'[\hat{b},\hat{e}]
+    pos_t max_scan_l_ = 128;
+    /* minimum number of occurrences of a pattern, s.t. its occurrences are decoded with the rlzdsa instead of
+       M_Phi^{-1} (only for support = _locate_hybrid) */
+    pos_t min_occ_rlzdsa = 0;
 
     /* true <=> the characters of the input have been remapped internally, because sym_t != char or
        the input invalid characters */
     bool symbols_remapped = false;
-    uint64_t size_map_int = 0; // size of _map_int (for byte_alphabet = false)
 
     // ############################# INDEX DATA STRUCTURES #############################
 
@@ -130,6 +221,16 @@ protected:
     // rank-select data structure for L'
     rsl_t _RS_L_;
 
+    /* The Move Data Structure for LF^k (only built by build_m_lf_k()); revert uses it to advance k positions in the
+    input per move query. */
+    move_data_structure<pos_t> _M_LF_k;
+    // [0..k*r_k-1] L_k[x*k+t] = L[LF^t(i)] for each i in the x-th input interval of M_LF^k and t in [0..k-1]
+    std::vector<i_sym_t> _L_k;
+
+    /* The Move Data Structure for FL = LF^{-1} (only built by build_m_fl()). It also stores F', which can be accessed at
+    position x with M_FL.L_(x), where F'[x] = F[M_FL.p(x)]; it is used to extract the input from left to right. */
+    move_data_structure_l_<pos_t, i_sym_t> _M_FL;
+
     // The Move Data Structure for Phi^{-1}.
     move_data_structure<pos_t> _M_Phi_m1;
     // [0..r'-1] stores at position x the index of the output interval of M_Phi^{-1} that starts with SA_s[x] = SA[M_LF.p[x]]
@@ -143,6 +244,8 @@ protected:
     interleaved_vectors<pos_t, pos_t> _SA_s;
     // reference for SA^d (differential suffix array)
     interleaved_vectors<uint64_t, pos_t> _R;
+    // path to the reference file R has been loaded from, if R is shared between multiple indexes (else empty)
+    std::string path_R = "";
     // bit vector storing the phrase types of the rlzdsa, i.e, PT[i] = 1 <=> phrase i is literal
     plain_bit_vector<pos_t, true, true, true> _PT;
     // compressed bit vector marking the sampled starting positions in SA^d of the copy phrases of the rlzdsa
@@ -156,6 +259,20 @@ protected:
 
     // ############################# INTERNAL METHODS #############################
 
+    /**
+     * @brief returns whether the occurrences of a pattern with num_occ occurrences should be decoded with the rlzdsa
+     * @param num_occ number of occurrences of the pattern
+     * @return whether to use the rlzdsa
+     */
+    inline bool use_rlzdsa(pos_t num_occ) const
+    {
+        if constexpr (support == _locate_hybrid) {
+            return num_occ >= min_occ_rlzdsa;
+        } else {
+            return has_rlzdsa;
+        }
+    }
+
     /**
      * @brief sets SA_Phi^{-1}[x] to idx
      * @param x [0..r-1]
@@ -166,8 +283,177 @@ protected:
         _SA_Phi_m1.template set<0, pos_t>(x, idx);
     }
 
+    /**
+     * @brief writes the header of a reference file
+     * @param out output stream
+     * @param n_R length of the input the reference has been built for
+     * @param sad_64 true <=> the values in SA^d are stored with 64 bits
+     * @param irr_pos_64 true <=> the index of rev(R) uses 64-bit positions
+     */
+    static void write_reference_header(std::ostream& out, uint64_t n_R, bool sad_64, bool irr_pos_64)
+    {
+        out.write((char*)&move_r_reference_magic, sizeof(uint64_t));
+        out.write((char*)&move_r_reference_format_version, sizeof(uint16_t));
+        out.write((char*)&n_R, sizeof(uint64_t));
+        out.write((char*)&sad_64, 1);
+        out.write((char*)&irr_pos_64, 1);
+    }
+
+    /**
+     * @brief reads and checks the header of a reference file written by export_reference()
+     * @param ref_file input stream storing the reference file
+     * @param path path of the reference file (for the error messages)
+     * @return (n_R, sad_64, irr_pos_64) (see write_reference_header())
+     */
+    static std::tuple<uint64_t, bool, bool> read_reference_header(std::istream& ref_file, const std::string& path)
+    {
+        if (!ref_file.good()) {
+            throw std::runtime_error("cannot open the reference file " + path);
+        }
+
+        uint64_t magic = 0;
+        uint16_t version = 0;
+        uint64_t n_R = 0;
+        bool sad_64 = false;
+        bool irr_pos_64 = false;
+        ref_file.read((char*)&magic, sizeof(uint64_t));
+        ref_file.read((char*)&version, sizeof(uint16_t));
+
+        if (!ref_file.good() || magic != move_r_reference_magic) {
+            throw std::runtime_error(path + " is not a move-r reference file");
+        }
+
+        if (version > move_r_reference_format_version) {
+            throw std::runtime_error(path + " has the unsupported reference file format version " + std::to_string(version));
+        }
+
+        ref_file.read((char*)&n_R, sizeof(uint64_t));
+        ref_file.read((char*)&sad_64, 1);
+        ref_file.read((char*)&irr_pos_64, 1);
+
+        if (!ref_file.good()) {
+            throw std::runtime_error("the reference file " + path + " is truncated");
+        }
+
+        return { n_R, sad_64, irr_pos_64 };
+    }
+
+    /**
+     * @brief loads R from the reference file path_R written by export_reference()
+     */
+    void load_reference_r()
+    {
+        std::ifstream ref_file(path_R);
+        read_reference_header(ref_file, path_R);
+        _R.load(ref_file);
+
+        if (ref_file.fail()) {
+            throw std::runtime_error("the reference file " + path_R + " is truncated");
+        }
+    }
+
+    /**
+     * @brief builds a move-r index of rev(R) and writes it to an output stream
+     * @tparam sad_t type of the values in SA^d
+     * @tparam irr_pos_t position type of the index of rev(R)
+     * @param out output stream
+     * @param num_threads maximum number of threads to use
+     */
+    template <typename sad_t, typename irr_pos_t>
+    void serialize_idx_rev_r(std::ostream& out, uint16_t num_threads) const
+    {
+        uint64_t size_R = _R.size();
+        std::vector<sad_t> revR;
+        no_init_resize(revR, size_R);
+
+        #pragma omp parallel for num_threads(num_threads)
+        for (uint64_t i = 0; i < size_R; i++) {
+            revR[i] = _R[size_R - i - 1];
+        }
+
+        move_r<_locate_one, sad_t, irr_pos_t>(std::move(revR), { .num_threads = num_threads }).serialize(out);
+    }
+
+    /**
+     * @brief copies the data structures needed for count queries (M_LF, L', RS_L' and the alphabet mapping) to another index
+     * @tparam new_support support of the other index
+     * @param index the other index
+     */
+    template <move_r_support new_support>
+    void copy_count_data_structures(move_r<new_support, sym_t, pos_t>& index) const
+    {
+        index.n = n;
+        index.sigma = sigma;
+        index.r = r;
+        index.r_ = r_;
+        index.a = a;
+        index.max_scan_l_ = max_scan_l_;
+        index.symbols_remapped = symbols_remapped;
+        index._map_int = _map_int;
+        index._map_ext = _map_ext;
+        index._M_LF = _M_LF;
+        index._RS_L_ = _RS_L_;
+        index.k_lf = k_lf;
+        index._M_LF_k = _M_LF_k;
+        index._L_k = _L_k;
+        index._M_FL = _M_FL;
+    }
+
+    /**
+     * @brief builds SCP_S (the sampled starting positions of the copy phrases of the rlzdsa) for the sample rate sr_scp
+     */
+    void build_scp_s()
+        requires(has_rlzdsa);
+
+    /**
+     * @brief returns the time (in ns) needed to query all patterns num_repetitions times (locate-queries if the index
+     * supports locating multiple occurrences, else count-queries)
+     * @param patterns patterns to query
+     * @param num_repetitions number of times to query each pattern
+     * @return time needed to query the patterns
+     */
+    uint64_t measure_query_time(const std::vector<inp_t>& patterns, uint8_t num_repetitions) const;
+
+    /**
+     * @brief builds an index of the input, derives candidates for different parameter values from it (by rebalancing it
+     * and rebuilding SCP_S) and keeps the one that answers queries for sample patterns the fastest, while using at most
+     * tuning.max_size_in_bytes bytes; the scan distance over L' is only tuned if the chosen configuration fits into
+     * the budget, since it does not change the size
+     * @param input the input (it must be kept in memory during the tuning)
+     * @param patterns sample patterns
+     * @param tuning tuning parameters
+     * @param params construction parameters (params.a, params.sr_scp and params.max_scan_l_ are ignored)
+     */
+    void tune(inp_t& input, const std::vector<inp_t>& patterns, move_r_tuning_params tuning, move_r_params params);
+
+    template <typename pck_t>
     class construction;
 
+    /**
+     * @brief runs the construction of this index; for pos_t = uint64_t, the intermediate arrays of size O(r) store their
+     * positions packed to 40 bits (see packed_t), unless the input is too long for them, then they store 64-bit positions
+     * @param input_size length of the input (including the terminator)
+     * @param args arguments of the construction (after the index)
+     */
+    template <typename... args_t>
+    void construct(uint64_t input_size, args_t&&... args)
+    {
+        if constexpr (std::is_same_v<pos_t, uint64_t>) {
+            if (input_size > uint40_t::max) {
+                construction<pos_t>(*this, std::forward<args_t>(args)...);
+                return;
+            }
+        }
+
+        construction<packed_t<pos_t>>(*this, std::forward<args_t>(args)...);
+    }
+
+    template <move_r_support, typename, typename>
+    friend class move_r;
+
+    template <move_r_support, typename, typename>
+    friend class move_r_bidirectional;
+
     // ############################# CONSTRUCTORS #############################
 
 public:
@@ -180,7 +466,7 @@ public:
      */
     move_r(inp_t& input, move_r_params params = {})
     {
-        construction(*this, input, false, params);
+        construct(input.size() + 1, input, false, params);
     }
 
     /**
@@ -190,7 +476,21 @@ public:
      */
     move_r(inp_t&& input, move_r_params params = {})
     {
-        construction(*this, input, true, params);
+        construct(input.size() + 1, input, true, params);
+    }
+
+    /**
+     * @brief constructs a move_r index of the input, s.t. the balancing parameter, the sample rate of the copy phrases
+     * in the rlzdsa and the maximum scan distance over L' are chosen to maximize the throughput of queries for the
+     * sample patterns within a memory budget (see move_r_tuning_params); the chosen values are stored in the index
+     * @param input the input
+     * @param patterns sample patterns
+     * @param tuning tuning parameters
+     * @param params construction parameters
+     */
+    move_r(inp_t& input, const std::vector<inp_t>& patterns, move_r_tuning_params tuning, move_r_params params = {})
+    {
+        tune(input, patterns, tuning, params);
     }
 
     /**
@@ -201,7 +501,24 @@ public:
     move_r(std::ifstream& input_file, move_r_params params = {})
         requires(str_input)
     {
-        construction(*this, input_file, params);
+        input_file.seekg(0, std::ios::end);
+        construct((uint64_t)input_file.tellg() + 1, input_file, params);
+    }
+
+    /**
+     * @brief constructs a move_r index from an input file, which is memory-mapped instead of read into memory; the
+     * mapping is read-only, unless the characters of the input have to be remapped (then it is copy-on-write); throws
+     * std::runtime_error if the file cannot be opened or mapped
+     * @param input_path path to the input file
+     * @param params construction parameters
+     */
+    template <typename path_t>
+    move_r(const path_t& input_path, move_r_params params = {})
+        requires(str_input && std::is_same_v<path_t, std::filesystem::path>)
+    {
+        std::error_code ec;
+        uint64_t file_size = std::filesystem::file_size(input_path, ec);
+        construct(ec ? 0 : file_size + 1, input_path, params);
     }
 
     /**
@@ -215,11 +532,198 @@ public:
     move_r(std::vector<sa_sint_t>& suffix_array, std::string& bwt, move_r_params params = {})
         requires(str_input)
     {
-        construction(*this, suffix_array, bwt, params);
+        construct(bwt.size(), suffix_array, bwt, params);
+    }
+
+    /**
+     * @brief constructs a move_r index from the run-length encoded bwt of the input without building the suffix array;
+     * the suffix array samples are obtained by traversing M_LF, so the construction uses O(r) words of space
+     * @param run_heads the characters of the bwt runs, where the terminator is the only occurrence of the character 0
+     * @param run_lengths the lengths of the bwt runs (adjacent runs with equal characters are merged)
+     * @param params construction parameters (params.mode is ignored)
+     */
+    move_r(const std::string& run_heads, const std::vector<pos_t>& run_lengths, move_r_params params = {})
+        requires(str_input && !has_rlzdsa)
+    {
+        construct(std::reduce(run_lengths.begin(), run_lengths.end(), uint64_t { 0 }), run_heads, run_lengths, params);
+    }
+
+    /**
+     * @brief builds move-r indexes of several inputs (e.g., the shards of a collection) concurrently in one process;
+     * params.num_threads is the thread budget shared by all constructions: min(|inputs|, params.num_threads) constructions
+     * run at the same time, each with an equal share of the threads (and of params.max_memory, which is only compared to
+     * the estimated peak memory usage of each construction), where the inputs are built in descending order of their
+     * lengths; the memory usage can only be measured for the whole process, not for a single construction, so log
+     * messages and measurement output are disabled, and if params.checkpoint_dir is set, the checkpoint of inputs[i] is
+     * written to its subdirectory i
+     * @param inputs the inputs
+     * @param params construction parameters
+     * @return the indexes, where the i-th index has been built for inputs[i]
+     */
+    static std::vector<move_r> build_concurrently(std::vector<inp_t>& inputs, move_r_params params = {})
+    {
+        uint64_t num_inputs = inputs.size();
+        uint16_t num_threads = std::max<uint16_t>(1, params.num_threads);
+        uint16_t num_workers = std::max<uint64_t>(1, std::min<uint64_t>(num_inputs, num_threads));
+        std::vector<move_r> indexes(num_inputs);
+
+        params.log = false;
+        params.mf_idx = NULL;
+        params.mf_mds = NULL;
+        params.max_memory /= num_workers;
+
+        // the longest inputs are built first, s.t. the workers finish at roughly the same time
+        std::vector<uint64_t> order(num_inputs);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint64_t i, uint64_t j) { return inputs[i].size() > inputs[j].size(); });
+
+        std::atomic<uint64_t> next = 0;
+        std::vector<std::exception_ptr> errors(num_workers);
+        std::vector<std::thread> workers;
+
+        for (uint16_t w = 0; w < num_workers; w++) {
+            // the threads are distributed as evenly as possible among the workers
+            move_r_params params_w = params;
+            params_w.num_threads = num_threads / num_workers + (w < num_threads % num_workers ? 1 : 0);
+
+            workers.emplace_back([&, params_w, w]() mutable {
+                try {
+                    for (uint64_t i = next++; i < num_inputs; i = next++) {
+                        if (!params.checkpoint_dir.empty()) {
+                            params_w.checkpoint_dir = (std::filesystem::path(params.checkpoint_dir) / std::to_string(order[i])).string();
+                        }
+
+                        indexes[order[i]] = move_r(inputs[order[i]], params_w);
+                    }
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        for (std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+
+        return indexes;
     }
 
     // ############################# MISC PUBLIC METHODS #############################
 
+    /**
+     * @brief rebalances M_LF (and M_Phi^{-1}) to a new balancing parameter without rebuilding the index from the input;
+     * L', RS_L', SA_s, SA_Phi^{-1} and D_e are rebuilt accordingly, the rlzdsa is not affected
+     * @param new_a new balancing parameter, 2 <= new_a
+     * @param num_threads maximum number of threads to use
+     * @param log controls, whether to print log messages
+     */
+    void rebalance(uint16_t new_a, uint16_t num_threads = omp_get_max_threads(), bool log = false)
+    {
+        construct(n, std::max<uint16_t>(2, new_a), num_threads, log);
+    }
+
+    /**
+     * @brief builds M_LF^k, the move data structure for LF^k, from the input intervals of M_LF (it has at most k*r'
+     * intervals before balancing), and L_k, which stores the k symbols L[i],L[LF(i)],...,L[LF^{k-1}(i)] of each of its
+     * input intervals; revert then performs one move query per k symbols; k = 1 removes M_LF^k again
+     * @param k number of LF-steps per move query (a power of two, e.g. 2 or 4; else it is rounded down to one)
+     * @param num_threads maximum number of threads to use
+     */
+    void build_m_lf_k(uint8_t k, uint16_t num_threads = omp_get_max_threads());
+
+    /**
+     * @brief builds M_FL, the move data structure for FL = LF^{-1}, by inverting the intervals of M_LF (balanced with the
+     * same balancing parameter), together with F'; it enables extracting the input from left to right starting at any
+     * suffix array position (see extract() and revert_forward())
+     * @param num_threads maximum number of threads to use
+     */
+    void build_m_fl(uint16_t num_threads = omp_get_max_threads());
+
+    /**
+     * @brief returns an index with locate support for the same input, built from this count-only index without the
+     * input or its suffix array; the suffix array samples are obtained by traversing M_LF, so this uses O(r) words of
+     * additional space (the rlzdsa needs the whole suffix array, so it cannot be built this way)
+     * @tparam new_support support of the returned index (_locate_one or _locate_move)
+     * @param num_threads maximum number of threads to use
+     * @param log controls, whether to print log messages
+     * @return the index with locate support
+     */
+    template <move_r_support new_support>
+    move_r<new_support, sym_t, pos_t> upgrade_to(uint16_t num_threads = omp_get_max_threads(), bool log = false) const
+        requires(!supports_locate && (new_support == _locate_one || new_support == _locate_move))
+    {
+        move_r<new_support, sym_t, pos_t> index;
+        copy_count_data_structures(index);
+        index.construct(n, num_threads, log);
+        return index;
+    }
+
+    /**
+     * @brief returns an index with a subset of the support of this index (e.g., a count-only or a locate_move index of a
+     * locate_hybrid index) by copying the data structures it needs, so an index can be built once with the support
+     * covering all needed supports and each of them can be obtained from it without repeating any construction phase
+     * @tparam new_support support of the returned index
+     * @param num_threads maximum number of threads to use
+     * @return the index with support new_support
+     */
+    template <move_r_support new_support>
+    move_r<new_support, sym_t, pos_t> downgrade_to(uint16_t num_threads = omp_get_max_threads()) const
+        requires(new_support == support || new_support == _count || (new_support == _locate_one && supports_locate) ||
+            (new_support == _locate_move && has_m_phi_m1) || (new_support == _locate_rlzdsa && has_rlzdsa))
+    {
+        if constexpr (new_support == support) {
+            return *this;
+        } else {
+            move_r<new_support, sym_t, pos_t> index;
+            copy_count_data_structures(index);
+
+            if constexpr (new_support == _locate_one || new_support == _locate_rlzdsa) {
+                if constexpr (has_m_phi_m1) {
+                    // recover SA_s from M_Phi^{-1}, where SA_Phi^{-1}[x] = r'' <=> no BWT run starts at M_LF.p(x)
+                    index._SA_s.resize_no_init(r_);
+
+                    #pragma omp parallel for num_threads(num_threads)
+                    for (uint64_t x = 0; x < r_; x++) {
+                        pos_t y = SA_Phi_m1(x);
+                        index._SA_s.template set<0, pos_t>(x, y == r__ ? n : _M_Phi_m1.q(y));
+                    }
+                } else {
+                    index._SA_s = _SA_s;
+                }
+            }
+
+            if constexpr (new_support == _locate_move) {
+                index.r__ = r__;
+                index.omega_idx = omega_idx;
+                index.p_r = p_r;
+                index._D_e = _D_e;
+                index._M_Phi_m1 = _M_Phi_m1;
+                index._SA_Phi_m1 = _SA_Phi_m1;
+            }
+
+            if constexpr (new_support == _locate_rlzdsa) {
+                index.z = z;
+                index.z_l = z_l;
+                index.z_c = z_c;
+                index.n_R = n_R;
+                index.sr_scp = sr_scp;
+                index._R = _R;
+                index.path_R = path_R;
+                index._PT = _PT;
+                index._SCP_S = _SCP_S;
+                index._CPL = _CPL;
+                index._SR = _SR;
+                index._LP = _LP;
+            }
+
+            return index;
+        }
+    }
+
     /**
      * @brief returns the size of the input
      * @return size of the input
@@ -252,7 +756,7 @@ public:
      * @return number of phrases in the rlzdsa
      */
     inline pos_t num_phrases_rlzdsa() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return z;
     }
@@ -262,7 +766,7 @@ public:
      * @return number of literal phrases in the rlzdsa
      */
     inline pos_t num_literal_phrases_rlzdsa() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return z_l;
     }
@@ -272,7 +776,7 @@ public:
      * @return number of copy phrases in the rlzdsa
      */
     inline pos_t num_copy_phrases_rlzdsa() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return z_c;
     }
@@ -286,12 +790,30 @@ public:
         return a;
     }
 
+    /**
+     * @brief returns the number k of LF-steps per move query with M_LF^k (1 if M_LF^k has not been built)
+     * @return k
+     */
+    inline uint8_t lf_steps() const
+    {
+        return k_lf;
+    }
+
+    /**
+     * @brief returns whether M_FL has been built (see build_m_fl())
+     * @return whether M_FL has been built
+     */
+    inline bool has_m_fl() const
+    {
+        return _M_FL.num_intervals() > 0;
+    }
+
     /**
      * @brief returns the number omega_idx of bits used by one entry in SA_Phi^{-1} (word width of SA_Phi^{-1})
      * @return omega_idx
      */
     inline uint8_t width_saphi() const
-        requires(support == _locate_move)
+        requires(has_m_phi_m1)
     {
         return omega_idx;
     }
@@ -305,27 +827,145 @@ public:
         return p_r;
     }
 
+    /**
+     * @brief returns the sample rate of the copy phrases in the rlzdsa
+     * @return sample rate of the copy phrases
+     */
+    inline pos_t sample_rate_rlzdsa() const
+        requires(has_rlzdsa)
+    {
+        return sr_scp;
+    }
+
+    /**
+     * @brief sets the sample rate of the copy phrases in the rlzdsa and rebuilds SCP_S accordingly
+     * @param sr sample rate of the copy phrases, 1 <= sr
+     */
+    void set_sample_rate_rlzdsa(pos_t sr)
+        requires(has_rlzdsa)
+    {
+        sr_scp = std::max<pos_t>(1, sr);
+        build_scp_s();
+    }
+
+    /**
+     * @brief returns the maximum distance to scan over L' to find the first and last occurrences of a symbol
+     * during backward search (only used for byte alphabets)
+     * @return maximum scan distance
+     */
+    inline pos_t max_scan_length() const
+    {
+        return max_scan_l_;
+    }
+
+    /**
+     * @brief sets the maximum distance to scan over L' to find the first and last occurrences of a symbol
+     * during backward search (only used for byte alphabets)
+     * @param max_scan maximum scan distance
+     */
+    inline void set_max_scan_length(pos_t max_scan)
+    {
+        max_scan_l_ = max_scan;
+    }
+
+    /**
+     * @brief returns the minimum number of occurrences of a pattern, s.t. its occurrences are decoded with the
+     * rlzdsa instead of M_Phi^{-1}
+     * @return minimum number of occurrences to use the rlzdsa
+     */
+    inline pos_t min_occ_threshold() const
+        requires(support == _locate_hybrid)
+    {
+        return min_occ_rlzdsa;
+    }
+
+    /**
+     * @brief sets the minimum number of occurrences of a pattern, s.t. its occurrences are decoded with the
+     * rlzdsa instead of M_Phi^{-1}
+     * @param min_occ minimum number of occurrences to use the rlzdsa
+     */
+    inline void set_min_occ_threshold(pos_t min_occ)
+        requires(support == _locate_hybrid)
+    {
+        min_occ_rlzdsa = min_occ;
+    }
+
+    /**
+     * @brief sets the minimum number of occurrences to use the rlzdsa to an estimate, which only depends on n and r':
+     * initializing the rlzdsa decodes on average n/(2r') suffix array values, and a move query with M_Phi^{-1} costs
+     * about as much as decoding 8 consecutive suffix array values with the rlzdsa; this is the default after the
+     * construction and after rebalancing
+     */
+    void estimate_min_occ_threshold()
+        requires(support == _locate_hybrid)
+    {
+        min_occ_rlzdsa = std::max<pos_t>(1, n / (16 * (uint64_t)r_));
+    }
+
+    /**
+     * @brief sets the minimum number of occurrences to use the rlzdsa by locating random patterns with
+     * (roughly) 2^0,2^1,...,2^16 occurrences with both M_Phi^{-1} and the rlzdsa and choosing the smallest
+     * power of two, from which on the rlzdsa is not slower than M_Phi^{-1}
+     * @param num_samples number of patterns to locate per power of two
+     * @param seed seed for choosing the patterns
+     */
+    void calibrate_min_occ_threshold(uint64_t num_samples = 64, uint64_t seed = 0)
+        requires(support == _locate_hybrid);
+
+    /**
+     * @brief returns the size of _map_int in bytes; for byte alphabets, it has a constant size and is not counted, and for
+     * integer alphabets, it is 0 if the symbols have not been remapped, else it is computed from the layout of
+     * tsl::sparse_map (with the default sparsity): the buckets are grouped into sparse arrays of 64 buckets, each of
+     * which stores two 64-bit bitmaps, a pointer to its values, its size and its capacity, which grows in steps of 4
+     * @return size of _map_int in bytes
+     */
+    uint64_t size_map_int() const
+    {
+        if constexpr (byte_alphabet) {
+            return 0;
+        } else {
+            if (_map_int.empty()) return 0;
+
+            uint64_t num_arrays = (_map_int.bucket_count() + 63) / 64;
+            // on average, half of a growth step is unused in each non-empty sparse array
+            uint64_t num_values = _map_int.size() + 3 * std::min<uint64_t>(num_arrays, _map_int.size()) / 2;
+            return sizeof(map_int_t) + 32 * num_arrays + sizeof(typename map_int_t::value_type) * num_values;
+        }
+    }
+
     /**
      * @brief returns the size of the data structure in bytes
      * @return size of the data structure in bytes
      */
     uint64_t size_in_bytes() const
     {
-        uint64_t size = 4 * sizeof(pos_t) + 3 + 2 * sizeof(uint16_t) + // variables
+        uint64_t size = 5 * sizeof(pos_t) + 3 + 2 * sizeof(uint16_t) + // variables
             p_r * sizeof(pos_t) + // D_e
             _M_LF.size_in_bytes() + // M_LF and L'
-            size_map_int + // map_int
+            size_map_int() + // map_int
             sizeof(sym_t) * sigma + // map_ext
             _RS_L_.size_in_bytes(); // RS_L'
 
-        if constexpr (support == _locate_one) {
+        if (k_lf > 1) {
+            size += 1 + _M_LF_k.size_in_bytes() + // M_LF^k
+                _L_k.size() * sizeof(i_sym_t); // L_k
+        }
+
+        if (has_m_fl()) {
+            size += _M_FL.size_in_bytes(); // M_FL and F'
+        }
+
+        if constexpr (support == _locate_one || support == _locate_rlzdsa) {
             size += _SA_s.size_in_bytes(); // SA_s
-        } else if constexpr (support == _locate_move) {
+        }
+
+        if constexpr (has_m_phi_m1) {
             size += _M_Phi_m1.size_in_bytes() + // M_Phi^{-1}
                 _SA_Phi_m1.size_in_bytes(); // SA_Phi^{-1}
-        } else if constexpr (support == _locate_rlzdsa) {
-            size += _SA_s.size_in_bytes() + // SA_s
-                _R.size_in_bytes() + // R
+        }
+
+        if constexpr (has_rlzdsa) {
+            size += _R.size_in_bytes() + // R
                 (z_c + 2) * sizeof(uint16_t) + // CPL
                 _SCP_S.size_in_bytes() + // SCP_S
                 _SR.size_in_bytes() + // SR
@@ -348,18 +988,32 @@ public:
         std::cout << "L': " << format_size(size_l_) << std::endl;
         std::cout << "RS_L': " << format_size(_RS_L_.size_in_bytes()) << std::endl;
 
+        if (k_lf > 1) {
+            std::cout << "M_LF^" << std::to_string(k_lf) << ": " << format_size(_M_LF_k.size_in_bytes()) << std::endl;
+            std::cout << "L_" << std::to_string(k_lf) << ": " << format_size(_L_k.size() * sizeof(i_sym_t)) << std::endl;
+        }
+
+        if (has_m_fl()) {
+            uint64_t size_f_ = (_M_FL.width_l_() / 8) * (_M_FL.num_intervals() + 1);
+            std::cout << "M_FL: " << format_size(_M_FL.size_in_bytes() - size_f_) << std::endl;
+            std::cout << "F': " << format_size(size_f_) << std::endl;
+        }
+
         if (int_alphabet && symbols_remapped) {
-            std::cout << "map_int: " << format_size(size_map_int) << std::endl;
+            std::cout << "map_int: " << format_size(size_map_int()) << std::endl;
             std::cout << "map_ext: " << format_size(sizeof(sym_t) * sigma) << std::endl;
         }
 
-        if constexpr (support == _locate_one) {
+        if constexpr (support == _locate_one || support == _locate_rlzdsa) {
             std::cout << "SA_s: " << format_size(_SA_s.size_in_bytes()) << std::endl;
-        } else if constexpr (support == _locate_move) {
+        }
+
+        if constexpr (has_m_phi_m1) {
             std::cout << "M_Phi^{-1}: " << format_size(_M_Phi_m1.size_in_bytes()) << std::endl;
             std::cout << "SA_Phi^{-1}: " << format_size(_SA_Phi_m1.size_in_bytes()) << std::endl;
-        } else if constexpr (support == _locate_rlzdsa) {
-            std::cout << "SA_s: " << format_size(_SA_s.size_in_bytes()) << std::endl;
+        }
+
+        if constexpr (has_rlzdsa) {
             std::cout << "R: " << format_size(_R.size_in_bytes()) << std::endl;
             std::cout << "CPL: " << format_size((z_c + 2) * sizeof(uint16_t)) << std::endl;
             std::cout << "SCP_S: " << format_size(_SCP_S.size_in_bytes()) << std::endl;
@@ -381,18 +1035,33 @@ public:
         out << " size_l_=" << size_l_;
         out << " size_rs_l_=" << _RS_L_.size_in_bytes();
 
+        if (k_lf > 1) {
+            out << " k_lf=" << std::to_string(k_lf);
+            out << " size_m_lf_k=" << _M_LF_k.size_in_bytes();
+            out << " size_l_k=" << _L_k.size() * sizeof(i_sym_t);
+        }
+
+        if (has_m_fl()) {
+            uint64_t size_f_ = (_M_FL.width_l_() / 8) * (_M_FL.num_intervals() + 1);
+            out << " size_m_fl=" << _M_FL.size_in_bytes() - size_f_;
+            out << " size_f_=" << size_f_;
+        }
+
         if (int_alphabet && symbols_remapped) {
-            out << " size_map_int=" << size_map_int;
+            out << " size_map_int=" << size_map_int();
             out << " size_map_ext=" << sizeof(sym_t) * sigma;
         }
 
-        if constexpr (support == _locate_one) {
+        if constexpr (support == _locate_one || support == _locate_rlzdsa) {
             out << "size_sa_s: " << _SA_s.size_in_bytes();
-        } else if constexpr (support == _locate_move) {
+        }
+
+        if constexpr (has_m_phi_m1) {
             out << " size_m_phim1=" << _M_Phi_m1.size_in_bytes();
             out << " size_sa_phim1=" << _SA_Phi_m1.size_in_bytes();
-        } else if constexpr (support == _locate_rlzdsa) {
-            out << "size_sa_s: " << _SA_s.size_in_bytes();
+        }
+
+        if constexpr (has_rlzdsa) {
             out << "size_r: " << _R.size_in_bytes();
             out << "size_cpl: " << (z_c + 2) * sizeof(uint16_t);
             out << "size_scp: " << _SCP_S.size_in_bytes();
@@ -413,12 +1082,30 @@ public:
         return _M_LF;
     }
 
+    /**
+     * @brief returns a reference to M_LF^k (empty if it has not been built, see build_m_lf_k())
+     * @return M_LF^k
+     */
+    inline const move_data_structure<pos_t>& M_LF_k() const
+    {
+        return _M_LF_k;
+    }
+
+    /**
+     * @brief returns a reference to M_FL (empty if it has not been built, see build_m_fl())
+     * @return M_FL
+     */
+    inline const move_data_structure_l_<pos_t, i_sym_t>& M_FL() const
+    {
+        return _M_FL;
+    }
+
     /**
      * @brief returns a reference to M_Phi^{-1}
      * @return M_Phi^{-1}
      */
     inline const move_data_structure<pos_t>& M_Phi_m1() const
-        requires(support == _locate_move)
+        requires(has_m_phi_m1)
     {
         return _M_Phi_m1;
     }
@@ -437,7 +1124,7 @@ public:
      * @return R
      */
     inline const interleaved_vectors<uint64_t, pos_t>& R() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _R;
     }
@@ -447,7 +1134,7 @@ public:
      * @return PT
      */
     inline const plain_bit_vector<pos_t, true, true, true>& PT() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _PT;
     }
@@ -457,7 +1144,7 @@ public:
      * @return CPL
      */
     inline const std::vector<uint16_t>& CPL() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _CPL;
     }
@@ -467,7 +1154,7 @@ public:
      * @return SCP_S
      */
     inline const sd_array<pos_t>& SCP_S() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _SCP_S;
     }
@@ -477,7 +1164,7 @@ public:
      * @return SR
      */
     inline const interleaved_vectors<pos_t, pos_t>& SR() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _SR;
     }
@@ -487,7 +1174,7 @@ public:
      * @return LP
      */
     inline const interleaved_vectors<pos_t, pos_t>& LP() const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _LP;
     }
@@ -498,7 +1185,7 @@ public:
      * @return R[x]
      */
     inline uint64_t R(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _R[x];
     }
@@ -509,7 +1196,7 @@ public:
      * @return PT[x]
      */
     inline bool PT(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _PT[x];
     }
@@ -520,7 +1207,7 @@ public:
      * @return CPL[x]
      */
     inline uint16_t CPL(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _CPL[x];
     }
@@ -531,7 +1218,7 @@ public:
      * @return SCP_S[x]
      */
     inline pos_t SCP_S(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _SCP_S.select_1(x + 1);
     }
@@ -542,7 +1229,7 @@ public:
      * @return SR[x]
      */
     inline pos_t SR(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _SR[x];
     }
@@ -553,7 +1240,7 @@ public:
      * @return LP[x]
      */
     inline pos_t LP(pos_t x) const
-        requires(support == _locate_rlzdsa)
+        requires(has_rlzdsa)
     {
         return _LP[x];
     }
@@ -564,7 +1251,7 @@ public:
      * @return SA_Phi^{-1}[x]
      */
     inline pos_t SA_Phi_m1(pos_t x) const
-        requires(support == _locate_move)
+        requires(has_m_phi_m1)
     {
         return _SA_Phi_m1[x];
     }
@@ -578,13 +1265,29 @@ public:
     inline pos_t SA_s(pos_t x) const
         requires(supports_locate)
     {
-        if constexpr (support == _locate_move) {
+        if constexpr (has_m_phi_m1) {
             return M_Phi_m1().q(SA_Phi_m1(x));
         } else {
             return _SA_s[x];
         }
     }
 
+    /**
+     * @brief returns whether SA_s[x] is sampled, i.e., whether the starting position of the x-th input
+     * interval in M_LF is a starting position of a bwt run
+     * @param x [0..r'-1]
+     * @return whether SA_s[x] is sampled
+     */
+    inline bool SA_s_sampled(pos_t x) const
+        requires(supports_locate)
+    {
+        if constexpr (has_m_phi_m1) {
+            return SA_Phi_m1(x) != r__;
+        } else {
+            return _SA_s[x] != n;
+        }
+    }
+
     /**
      * @brief returns L'[x]
      * @param x [0..r'-1]
@@ -667,6 +1370,29 @@ public:
     pos_t SA(pos_t i) const
         requires(supports_multiple_locate);
 
+    /**
+     * @brief reports the symbols T[SA[i],SA[i]+m-1] of the input from left to right, where the extraction stops at the end
+     * of the input; e.g., for i in sa_interval() of a query context, this reports the occurrence and the symbols following
+     * it (M_FL has to be built, see build_m_fl())
+     * @param i [0..input size]
+     * @param m number of symbols to extract
+     * @param report function that is called with every tuple (t,c) as a parameter, where c = T[SA[i]+t]
+     */
+    void extract(pos_t i, pos_t m, const std::function<void(pos_t, sym_t)>& report) const;
+
+    /**
+     * @brief returns T[SA[i],min(SA[i]+m-1,input size-1)] (M_FL has to be built, see build_m_fl())
+     * @param i [0..input size]
+     * @param m number of symbols to extract
+     * @return T[SA[i],min(SA[i]+m-1,input size-1)]
+     */
+    inp_t extract(pos_t i, pos_t m) const
+    {
+        inp_t T_i;
+        extract(i, m, [&T_i](pos_t, sym_t c) { T_i.push_back(c); });
+        return T_i;
+    }
+
     /**
      * @brief stores the variables needed to perform count- and locate-queries
      */
@@ -749,6 +1475,14 @@ public:
          */
         bool prepend(sym_t sym);
 
+        /**
+         * @brief returns the query contexts of all patterns symP, where P is the currently matched pattern and sym
+         * occurs in L[b,e], in ascending order of the symbols; the symbols are found in one scan over the (sub-)runs
+         * in L'[b_,e_], or with RS_L' if there are more of them than symbols in the alphabet
+         * @return pairs (sym,query context of symP)
+         */
+        std::vector<std::pair<sym_t, query_context>> children() const;
+
         /**
          * @brief reports the next occurrence of the currently matched pattern
          * @return next occurrence
@@ -841,6 +1575,15 @@ protected:
         pos_t& hat_b_ap_y, int64_t& y,
         pos_t& hat_e_ap_z, int64_t& z) const;
 
+    /**
+     * @brief sets b <- LF(b) and e <- LF(e), where L[b] = L[e]
+     * @param b Left interval limit of the suffix array interval.
+     * @param e Right interval limit of the suffix array interval.
+     * @param b_ index of the input interval in M_LF containing b.
+     * @param e_ index of the input interval in M_LF containing e.
+     */
+    inline void lf_interval(pos_t& b, pos_t& e, pos_t& b_, pos_t& e_) const;
+
     /**
      * @brief Sets the up a Phi^{-1}-move-pair for the suffix array sample at the starting position of the x-th input interval in M_LF
      * @param x an input interval in M_LF (the end position of the x-th input interval in M_LF must be a starting position of a BWT run)
@@ -848,7 +1591,7 @@ protected:
      * @param s_ variable to store the index of the input interval in M_Phi^{-1} containing s
      */
     inline void setup_phi_m1_move_pair(pos_t& x, pos_t& s, pos_t& s_) const
-        requires(support == _locate_move);
+        requires(has_m_phi_m1);
 
     /**
      * @brief prepares the variables to decode SA[b]
@@ -863,7 +1606,7 @@ protected:
         pos_t& b, pos_t& e,
         pos_t& s, pos_t& s_,
         pos_t& hat_b_ap_y, int64_t& y) const
-        requires(support == _locate_move);
+        requires(has_m_phi_m1);
 
     /**
      * @brief prepares the variables to decode SA[i]
@@ -877,7 +1620,7 @@ protected:
     inline void init_rlzdsa(
         pos_t& i,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief prepares the context to decode SA[i]; if there
@@ -893,7 +1636,7 @@ protected:
     inline void init_rlzdsa(
         pos_t& i, pos_t& s,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief decodes and stores SA[i] in s and prepares the context to decode
@@ -909,7 +1652,7 @@ protected:
     inline void next_rlzdsa(
         pos_t& i, pos_t& s,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief locates the remaining (not yet reported) occurrences of the currently matched pattern
@@ -928,7 +1671,7 @@ protected:
         pos_t& i, pos_t& e, pos_t& s,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np,
         std::vector<pos_t>& vec, pos_t o) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief locates the remaining (not yet reported) occurrences of the currently matched pattern
@@ -946,7 +1689,7 @@ protected:
         pos_t& i, pos_t& e, pos_t& s,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np,
         const std::function<void(pos_t, pos_t)>& report) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief advances the rlzdsa context to the right up to position e
@@ -962,7 +1705,7 @@ protected:
     inline void skip_rlzdsa_right(
         pos_t& i, pos_t& e, pos_t& s,
         pos_t& x_p, pos_t& x_lp, pos_t& x_cp, pos_t& x_r, pos_t& s_np) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
 public:
     /**
@@ -1104,9 +1847,24 @@ public:
     void revert(std::string file_name, retrieve_params params = {}) const
     {
         adjust_retrieve_params(params, n - 2);
-        retrieve_range<sym_t, true>(&move_r<support, sym_t, pos_t>::revert, file_name, params);
+
+        if (has_m_fl()) {
+            retrieve_range<sym_t, false>(&move_r<support, sym_t, pos_t>::revert_forward, file_name, params);
+        } else {
+            retrieve_range<sym_t, true>(&move_r<support, sym_t, pos_t>::revert, file_name, params);
+        }
     }
 
+    /**
+     * @brief reports the characters in the input in the range [l,r] (0 <= l <= r < input size) with M_FL, else if l > r,
+     * then all characters of the input are reported (default); if num_threads = 1, then the values are reported from left
+     * to right, if num_threads > 1, then each thread reports its section from left to right; if M_FL has not been built
+     * (see build_m_fl()), revert() is used instead
+     * @param report function that is called with every tuple (i,c) as a parameter, where i in [l,r] and c = input[i]
+     * @param params parameters
+     */
+    void revert_forward(const std::function<void(pos_t, sym_t)>& report, retrieve_params params = {}) const;
+
     /**
      * @brief rebuilds and returns the suffix array in the range [l,r] (0 <= l <= r <= input size),
      * else if l > r, then the whole suffix array is rebuilt (default)
@@ -1141,7 +1899,7 @@ public:
      * @param params parameters
      */
     void SA(std::vector<pos_t>& SA_range, retrieve_params params = {}) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief reports the suffix array values in the range [l,r] (0 <= l <= r <= input size), else if l > r, then the
@@ -1161,7 +1919,7 @@ public:
      * @param params parameters
      */
     void SA(const std::function<void(pos_t, pos_t)>& report, retrieve_params params = {}) const
-        requires(support == _locate_rlzdsa);
+        requires(has_rlzdsa);
 
     /**
      * @brief writes the values in the suffix array of the input in the range [l,r] blockwise to the file out (0 <= l <= r <= input size),
@@ -1184,6 +1942,8 @@ public:
      */
     void serialize(std::ostream& out) const
     {
+        out.write((char*)&move_r_index_magic, sizeof(uint64_t));
+        out.write((char*)&move_r_index_format_version, sizeof(uint16_t));
         bool is_64_bit = std::is_same_v<pos_t, uint64_t>;
         out.write((char*)&is_64_bit, 1);
         move_r_support _support = support;
@@ -1198,6 +1958,7 @@ public:
         out.write((char*)&r_, sizeof(pos_t));
         out.write((char*)&a, sizeof(uint16_t));
         out.write((char*)&p_r, sizeof(uint16_t));
+        out.write((char*)&max_scan_l_, sizeof(pos_t));
 
         if (p_r > 0) {
             out.write((char*)&_D_e[0], (p_r - 1) * 2 * sizeof(pos_t));
@@ -1220,19 +1981,40 @@ public:
 
         if constexpr (support == _locate_one) {
             _SA_s.serialize(out);
-        } else if constexpr (support == _locate_move) {
+        }
+
+        if constexpr (has_m_phi_m1) {
             out.write((char*)&r__, sizeof(pos_t));
             _M_Phi_m1.serialize(out);
 
             out.write((char*)&omega_idx, 1);
             _SA_Phi_m1.serialize(out);
-        } else if constexpr (support == _locate_rlzdsa) {
+        }
+
+        if constexpr (has_rlzdsa) {
             out.write((char*)&z, sizeof(pos_t));
             out.write((char*)&z_l, sizeof(pos_t));
             out.write((char*)&z_c, sizeof(pos_t));
+            out.write((char*)&sr_scp, sizeof(pos_t));
+
+            if constexpr (support == _locate_rlzdsa) {
+                _SA_s.serialize(out);
+            } else {
+                out.write((char*)&min_occ_rlzdsa, sizeof(pos_t));
+            }
+
+            out.write((char*)&n_R, sizeof(pos_t));
+            bool R_embedded = path_R.empty();
+            out.write((char*)&R_embedded, 1);
+
+            if (R_embedded) {
+                _R.serialize(out);
+            } else {
+                uint64_t path_R_length = path_R.size();
+                out.write((char*)&path_R_length, sizeof(uint64_t));
+                out.write((char*)&path_R[0], path_R_length);
+            }
 
-            _SA_s.serialize(out);
-            _R.serialize(out);
             _SCP_S.serialize(out);
             write_to_file(out, (char*)&_CPL[0], (z_c + 2) * sizeof(uint16_t));
             _SR.serialize(out);
@@ -1240,6 +2022,21 @@ public:
             _PT.serialize(out);
         }
 
+        // M_LF^k and M_FL are stored last, s.t. indexes that have been serialized without them can still be loaded
+        out.write((char*)&k_lf, 1);
+
+        if (k_lf > 1) {
+            _M_LF_k.serialize(out);
+            write_to_file(out, (char*)&_L_k[0], _L_k.size() * sizeof(i_sym_t));
+        }
+
+        bool m_fl = has_m_fl();
+        out.write((char*)&m_fl, 1);
+
+        if (m_fl) {
+            _M_FL.serialize(out);
+        }
+
         std::streamoff offs_end = out.tellp() - pos_data_structure_offsets;
         out.seekp(pos_data_structure_offsets, std::ios::beg);
         out.write((char*)&offs_end, sizeof(std::streamoff));
@@ -1247,23 +2044,47 @@ public:
     }
 
     /**
-     * @brief reads a serialized index from an input stream
+     * @brief reads a serialized index from an input stream; throws std::runtime_error if the stream does not store
+     * an index of this type
      * @param in an input stream storing a serialized index
      */
     void load(std::istream& in)
     {
-        bool is_64_bit;
+        std::streampos pos_start = in.tellg();
+        uint64_t magic = 0;
+        uint16_t version = 0;
+        in.read((char*)&magic, sizeof(uint64_t));
+
+        if (in.good() && magic == move_r_index_magic) {
+            in.read((char*)&version, sizeof(uint16_t));
+
+            if (version > move_r_index_format_version) {
+                throw std::runtime_error("unsupported index format version " + std::to_string(version));
+            }
+        } else {
+            in.clear();
+            in.seekg(pos_start, std::ios::beg);
+        }
+
+        uint8_t is_64_bit = 0;
         in.read((char*)&is_64_bit, 1);
 
+        if (!in.good() || is_64_bit > 1) {
+            throw std::runtime_error("the input stream does not store a move-r index");
+        }
+
         if (is_64_bit != std::is_same_v<pos_t, uint64_t>) {
-            std::cout << "error: cannot load a" << (is_64_bit ? "64" : "32") << "-bit"
-                      << " index into a " << (is_64_bit ? "32" : "64") << "-bit index-object" << std::flush;
-            return;
+            throw std::runtime_error(std::string("cannot load a ") + (is_64_bit ? "64" : "32") + "-bit"
+                + " index into a " + (is_64_bit ? "32" : "64") + "-bit index-object");
         }
 
         move_r_support _support;
         in.read((char*)&_support, sizeof(move_r_support));
 
+        if (_support != support) {
+            throw std::runtime_error("the index has been built with a different support");
+        }
+
         std::streampos pos_data_structure_offsets = in.tellg();
         std::streamoff offs_end;
         in.read((char*)&offs_end, sizeof(std::streamoff));
@@ -1274,6 +2095,8 @@ public:
         in.read((char*)&r_, sizeof(pos_t));
         in.read((char*)&a, sizeof(uint16_t));
         in.read((char*)&p_r, sizeof(uint16_t));
+        max_scan_l_ = 128;
+        if (version >= 1) in.read((char*)&max_scan_l_, sizeof(pos_t));
 
         if (p_r > 0) {
             _D_e.resize(p_r - 1);
@@ -1295,9 +2118,7 @@ public:
                 std::vector<std::pair<sym_t, i_sym_t>> map_int_vec;
                 no_init_resize(map_int_vec, sigma);
                 read_from_file(in, (char*)&map_int_vec[0], sizeof(std::pair<sym_t, i_sym_t>) * sigma);
-                uint64_t alloc_before = malloc_count_current();
                 _map_int.insert(map_int_vec.begin(), map_int_vec.end());
-                size_map_int = malloc_count_current() - alloc_before;
             }
         }
 
@@ -1306,19 +2127,49 @@ public:
 
         if constexpr (support == _locate_one) {
             _SA_s.load(in);
-        } else if constexpr (support == _locate_move) {
+        }
+
+        if constexpr (has_m_phi_m1) {
             in.read((char*)&r__, sizeof(pos_t));
             _M_Phi_m1.load(in);
 
             in.read((char*)&omega_idx, 1);
             _SA_Phi_m1.load(in);
-        } else if constexpr (support == _locate_rlzdsa) {
+        }
+
+        if constexpr (has_rlzdsa) {
             in.read((char*)&z, sizeof(pos_t));
             in.read((char*)&z_l, sizeof(pos_t));
             in.read((char*)&z_c, sizeof(pos_t));
+            sr_scp = 4;
+            if (version >= 1) in.read((char*)&sr_scp, sizeof(pos_t));
+
+            if constexpr (support == _locate_rlzdsa) {
+                _SA_s.load(in);
+            } else {
+                in.read((char*)&min_occ_rlzdsa, sizeof(pos_t));
+            }
+
+            // before version 1, R has always been built for the input and been embedded into the index
+            n_R = n;
+            bool R_embedded = true;
+
+            if (version >= 1) {
+                in.read((char*)&n_R, sizeof(pos_t));
+                in.read((char*)&R_embedded, 1);
+            }
+
+            if (R_embedded) {
+                path_R.clear();
+                _R.load(in);
+            } else {
+                uint64_t path_R_length;
+                in.read((char*)&path_R_length, sizeof(uint64_t));
+                path_R.resize(path_R_length);
+                in.read((char*)&path_R[0], path_R_length);
+                load_reference_r();
+            }
 
-            _SA_s.load(in);
-            _R.load(in);
             _SCP_S.load(in);
             no_init_resize(_CPL, z_c + 2);
             read_from_file(in, (char*)&_CPL[0], (z_c + 2) * sizeof(uint16_t));
@@ -1327,9 +2178,64 @@ public:
             _PT.load(in);
         }
 
+        k_lf = 1;
+        _M_LF_k = move_data_structure<pos_t>();
+        _L_k.clear();
+        _M_FL = move_data_structure_l_<pos_t, i_sym_t>();
+
+        if (in.tellg() < pos_data_structure_offsets + offs_end) {
+            in.read((char*)&k_lf, 1);
+
+            if (k_lf > 1) {
+                _M_LF_k.load(in);
+                no_init_resize(_L_k, k_lf * (uint64_t)_M_LF_k.num_intervals());
+                read_from_file(in, (char*)&_L_k[0], _L_k.size() * sizeof(i_sym_t));
+            }
+        }
+
+        if (in.tellg() < pos_data_structure_offsets + offs_end) {
+            bool m_fl;
+            in.read((char*)&m_fl, 1);
+
+            if (m_fl) {
+                _M_FL.load(in);
+            }
+        }
+
+        if (in.fail()) {
+            throw std::runtime_error("the serialized index is truncated");
+        }
+
         in.seekg(pos_data_structure_offsets + offs_end, std::ios::beg);
     }
 
+    /**
+     * @brief writes the reference (R) of the rlzdsa together with a move-r index of rev(R) to an output stream; other
+     *        indexes can then be built relative to this reference (see move_r_params::path_reference), which avoids
+     *        choosing R and building the index of rev(R) again
+     * @param out output stream to write the reference to
+     * @param num_threads maximum number of threads to use while building the index of rev(R)
+     */
+    void export_reference(std::ostream& out, uint16_t num_threads = omp_get_max_threads()) const
+        requires(has_rlzdsa)
+    {
+        uint64_t n_R_u64 = n_R;
+        // the value and position types of the index of rev(R) are chosen like during the construction of the rlzdsa
+        bool sad_64 = std::is_same_v<pos_t, uint64_t> && 2 * n_R_u64 > UINT_MAX;
+        bool irr_pos_64 = sad_64 && _R.size() >= UINT_MAX;
+
+        write_reference_header(out, n_R_u64, sad_64, irr_pos_64);
+        _R.serialize(out);
+
+        if (!sad_64) {
+            serialize_idx_rev_r<uint32_t, uint32_t>(out, num_threads);
+        } else if (!irr_pos_64) {
+            serialize_idx_rev_r<uint64_t, uint32_t>(out, num_threads);
+        } else {
+            serialize_idx_rev_r<uint64_t, uint64_t>(out, num_threads);
+        }
+    }
+
     std::ostream& operator>>(std::ostream& os) const
     {
         serialize(os);
@@ -1344,4 +2250,5 @@ public:
 };
 
 #include "algorithms/construction/construction.hpp"
-#include "algorithms/queries.cpp"
\ No newline at end of file
+#include "algorithms/queries.cpp"
+#include "algorithms/tuning.cpp"
\ No newline at end of file
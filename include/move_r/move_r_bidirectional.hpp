@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <move_r/move_r.hpp>
+#include <sdsl/rmq_support.hpp>
+
+/**
+ * @brief bidirectional move-r index, stores a move-r index of the input T and a count-only move-r index of its reverse
+ * rev(T); a bidirectional query context keeps the suffix array intervals of a pattern P in T and of rev(P) in rev(T)
+ * synchronized, s.t. P can be extended by symbols to the left (prepend) and to the right (append)
+ * @tparam support locate support of the index of T
+ * @tparam sym_t value type (default: char for strings)
+ * @tparam pos_t index integer type (use uint32_t if input size < UINT_MAX, else uint64_t)
+ */
+template <move_r_support support = _count, typename sym_t = char, typename pos_t = uint32_t>
+class move_r_bidirectional {
+public:
+    using idx_fwd_t = move_r<support, sym_t, pos_t>; // type of the index of T
+    using idx_rev_t = move_r<_count, sym_t, pos_t>; // type of the index of rev(T)
+    using inp_t = typename idx_fwd_t::inp_t; // input container type
+
+protected:
+    using i_sym_t = typename idx_fwd_t::i_sym_t; // internal (unsigned) symbol type
+
+    idx_fwd_t idx_fwd; // index of T
+    idx_rev_t idx_rev; // index of rev(T)
+
+    /**
+     * @brief variables of a backward search in one of the two indexes
+     */
+    struct search_state {
+        pos_t b, e, b_, e_, hat_b_ap_y, hat_e_ap_z; // variables for backward search
+        int64_t y, z; // variables for backward search
+    };
+
+    using rmq_t = sdsl::rmq_succinct_sct<>; // range minimum query support
+
+    /* range minimum query supports over the array prev of each index, where prev[x] = 1 + the position of the
+       previous occurrence of L'[x] in L' (0 <=> there is none); L'[x] is the first occurrence of its symbol in
+       L'[b_,e_] <=> prev[x] <= b_, hence the distinct symbols in L'[b_,e_] can be enumerated with range minimum queries */
+    rmq_t rmq_fwd; // for the index of T
+    rmq_t rmq_rev; // for the index of rev(T)
+
+    /**
+     * @brief builds the range minimum query support over the previous occurrences of the symbols in L' of an index
+     * @param idx an index
+     * @return the range minimum query support
+     */
+    template <move_r_support idx_support>
+    static rmq_t build_rmq_prev(const move_r<idx_support, sym_t, pos_t>& idx)
+    {
+        pos_t r_ = idx.M_LF().num_intervals();
+        std::vector<pos_t> prev;
+        no_init_resize(prev, r_);
+        std::vector<pos_t> last(idx_fwd_t::byte_alphabet ? 256 : idx.RS_L_().alphabet_size(), 0);
+
+        for (pos_t x = 0; x < r_; x++) {
+            i_sym_t v = idx.L_(x);
+            prev[x] = last[v];
+            last[v] = x + 1;
+        }
+
+        return rmq_t(&prev);
+    }
+
+    /**
+     * @brief returns the number of positions i in the suffix array interval [b,e] of an index with L[i] < sym; the
+     * distinct symbols v in L'[b_,e_] are enumerated with range minimum queries, and the occurrences of each v < sym
+     * in L[b,e] are counted in O(1) rank- and select-queries by LF-mapping its first and last occurrence in L[b,e];
+     * hence, this takes O(d) time, where d <= min(e_-b_+1, sigma) is the number of distinct symbols in L'[b_,e_]
+     * @param idx an index
+     * @param rmq the range minimum query support over the previous occurrences of the symbols in L' of idx
+     * @param s the suffix array interval [b,e] in idx
+     * @param sym a symbol in the internal alphabet of idx
+     * @return number of positions i in [b,e] with L[i] < sym
+     */
+    template <move_r_support idx_support>
+    static pos_t count_smaller(const move_r<idx_support, sym_t, pos_t>& idx, const rmq_t& rmq, const search_state& s, i_sym_t sym)
+    {
+        pos_t cnt = 0;
+        count_smaller(idx, rmq, s, sym, s.b_, s.e_, cnt);
+        return cnt;
+    }
+
+    /**
+     * @brief adds the number of occurrences in L[b,e] of each symbol v < sym, whose first occurrence in L'[b_,e_] lies
+     * in L'[l,r], to cnt; recurses into the smaller and iterates over the larger part, s.t. the recursion depth is
+     * O(log(r-l+1))
+     * @param idx an index
+     * @param rmq the range minimum query support over the previous occurrences of the symbols in L' of idx
+     * @param s the suffix array interval [b,e] in idx
+     * @param sym a symbol in the internal alphabet of idx
+     * @param l left end of the range in L'[b_,e_]
+     * @param r right end of the range in L'[b_,e_]
+     * @param cnt the number of positions i in [b,e] with L[i] < sym counted so far
+     */
+    template <move_r_support idx_support>
+    static void count_smaller(
+        const move_r<idx_support, sym_t, pos_t>& idx, const rmq_t& rmq,
+        const search_state& s, i_sym_t sym, pos_t l, pos_t r, pos_t& cnt)
+    {
+        const auto& M_LF = idx.M_LF();
+        const auto& RS_L_ = idx.RS_L_();
+
+        while (true) {
+            pos_t x_b = rmq(l, r);
+            i_sym_t v = idx.L_(x_b);
+            pos_t rnk_b = RS_L_.rank(v, s.b_);
+
+            // if the previous occurrence of L'[x_b] lies in L'[b_,x_b-1], then no symbol occurs first in L'[l,r]
+            if (RS_L_.rank(v, x_b) != rnk_b) {
+                return;
+            }
+
+            if (v < sym) {
+                // the occurrences of v in L'[b_,e_] are L'[x_b],...,L'[x_e]
+                pos_t x_e = RS_L_.select(v, RS_L_.rank(v, s.e_ + 1));
+
+                // the first and last occurrence of v in L[b,e]
+                pos_t i_b = std::max<pos_t>(s.b, M_LF.p(x_b));
+                pos_t i_e = std::min<pos_t>(s.e, M_LF.p(x_e + 1) - 1);
+
+                // LF is strictly increasing on the occurrences of v, hence there are LF(i_e)-LF(i_b)+1 of them in L[i_b,i_e]
+                cnt += (M_LF.q(x_e) + (i_e - M_LF.p(x_e))) - (M_LF.q(x_b) + (i_b - M_LF.p(x_b))) + 1;
+            }
+
+            if (x_b - l < r - x_b) {
+                if (x_b > l) count_smaller(idx, rmq, s, sym, l, x_b - 1, cnt);
+                l = x_b + 1;
+            } else {
+                if (x_b < r) count_smaller(idx, rmq, s, sym, x_b + 1, r, cnt);
+                if (x_b == l) return;
+                r = x_b - 1;
+            }
+        }
+    }
+
+public:
+    move_r_bidirectional() = default;
+
+    /**
+     * @brief constructs a bidirectional move-r index of the input
+     * @param input the input
+     * @param params construction parameters (used for both indexes)
+     */
+    move_r_bidirectional(const inp_t& input, move_r_params params = {})
+    {
+        inp_t input_rev(input.rbegin(), input.rend());
+        idx_rev = idx_rev_t(std::move(input_rev), params);
+        inp_t input_fwd = input;
+        idx_fwd = idx_fwd_t(std::move(input_fwd), params);
+        rmq_fwd = build_rmq_prev(idx_fwd);
+        rmq_rev = build_rmq_prev(idx_rev);
+    }
+
+    /**
+     * @brief returns the index of the input T
+     * @return index of T
+     */
+    inline const idx_fwd_t& index_fwd() const
+    {
+        return idx_fwd;
+    }
+
+    /**
+     * @brief returns the (count-only) index of the reversed input rev(T)
+     * @return index of rev(T)
+     */
+    inline const idx_rev_t& index_rev() const
+    {
+        return idx_rev;
+    }
+
+    /**
+     * @brief returns the size of the input
+     * @return size of the input
+     */
+    inline pos_t input_size() const
+    {
+        return idx_fwd.input_size();
+    }
+
+    /**
+     * @brief returns the size of the data structure in bytes
+     * @return size of the data structure in bytes
+     */
+    uint64_t size_in_bytes() const
+    {
+        return idx_fwd.size_in_bytes() + idx_rev.size_in_bytes() + sdsl::size_in_bytes(rmq_fwd) + sdsl::size_in_bytes(rmq_rev);
+    }
+
+    /**
+     * @brief serializes the index to an output stream
+     * @param out output stream
+     */
+    void serialize(std::ostream& out) const
+    {
+        idx_fwd.serialize(out);
+        idx_rev.serialize(out);
+    }
+
+    /**
+     * @brief loads the index from an input stream
+     * @param in input stream
+     */
+    void load(std::istream& in)
+    {
+        idx_fwd.load(in);
+        idx_rev.load(in);
+
+        // the range minimum query support is not serialized, since it can be rebuilt from the indexes
+        rmq_fwd = build_rmq_prev(idx_fwd);
+        rmq_rev = build_rmq_prev(idx_rev);
+    }
+
+    /**
+     * @brief stores the suffix array interval of a pattern P in T and of rev(P) in rev(T)
+     */
+    struct bidirectional_query_context {
+    protected:
+        pos_t l; // length of the currently matched pattern
+        search_state s_fwd; // backward search variables for P in the index of T
+        search_state s_rev; // backward search variables for rev(P) in the index of rev(T)
+
+        const move_r_bidirectional<support, sym_t, pos_t>* idx; // index to query
+
+        /**
+         * @brief performs a backward search step with sym in the index idx_1 and narrows the suffix array interval
+         * in the index idx_2 accordingly (idx_1 and idx_2 are the two indexes of a bidirectional index); besides the
+         * backward search step, this takes O(d) time for count_smaller() (see there) and O(log(e_-b_+1)) time for
+         * narrowing the interval in idx_2, hence it is not bounded by O(a) amortized time for large alphabets
+         * @param idx_1 index to perform the backward search step in
+         * @param rmq_1 the range minimum query support over the previous occurrences of the symbols in L' of idx_1
+         * @param s_1 backward search variables in idx_1
+         * @param idx_2 the other index
+         * @param s_2 backward search variables in idx_2
+         * @param sym symbol to extend the pattern with
+         * @return whether the extended pattern occurs in the input
+         */
+        template <move_r_support support_1, move_r_support support_2>
+        static bool extend(
+            const move_r<support_1, sym_t, pos_t>& idx_1, const rmq_t& rmq_1, search_state& s_1,
+            const move_r<support_2, sym_t, pos_t>& idx_2, search_state& s_2,
+            sym_t sym)
+        {
+            search_state s_1_old = s_1;
+
+            if (!idx_1.backward_search_step(sym, s_1.b, s_1.e, s_1.b_, s_1.e_, s_1.hat_b_ap_y, s_1.y, s_1.hat_e_ap_z, s_1.z)) {
+                s_1 = s_1_old;
+                return false;
+            }
+
+            /* the suffixes of the extended pattern in the other index are those suffixes in its current interval, that
+            are followed by sym; they come after the ones followed by a symbol less than sym */
+            pos_t b = s_2.b + count_smaller(idx_1, rmq_1, s_1_old, idx_1.map_symbol(sym));
+            pos_t e = b + (s_1.e - s_1.b);
+            const auto& M_LF = idx_2.M_LF();
+
+            s_2.b_ = bin_search_max_leq<pos_t>(b, s_2.b_, s_2.e_, [&M_LF](pos_t x) { return M_LF.p(x); });
+            s_2.e_ = bin_search_max_leq<pos_t>(e, s_2.b_, s_2.e_, [&M_LF](pos_t x) { return M_LF.p(x); });
+            s_2.b = b;
+            s_2.e = e;
+
+            // the suffix array sample variables are not valid for a narrowed interval
+            s_2.hat_b_ap_y = s_2.b_;
+            s_2.y = -1;
+            s_2.hat_e_ap_z = s_2.e_;
+            s_2.z = -1;
+
+            return true;
+        }
+
+    public:
+        /**
+         * @brief constructs a new bidirectional query context for the index idx
+         * @param idx an index
+         */
+        bidirectional_query_context(const move_r_bidirectional<support, sym_t, pos_t>& idx)
+        {
+            this->idx = &idx;
+            reset();
+        }
+
+        /**
+         * @brief resets the query context to an empty pattern
+         */
+        inline void reset()
+        {
+            idx->idx_fwd.init_backward_search(s_fwd.b, s_fwd.e, s_fwd.b_, s_fwd.e_, s_fwd.hat_b_ap_y, s_fwd.y, s_fwd.hat_e_ap_z, s_fwd.z);
+            idx->idx_rev.init_backward_search(s_rev.b, s_rev.e, s_rev.b_, s_rev.e_, s_rev.hat_b_ap_y, s_rev.y, s_rev.hat_e_ap_z, s_rev.z);
+            l = 0;
+        }
+
+        /**
+         * @brief returns the length of the currently matched pattern
+         * @return length of the currently matched pattern
+         */
+        inline pos_t length() const
+        {
+            return l;
+        }
+
+        /**
+         * @brief returns the number of occurrences of the currently matched pattern
+         * @return number of occurrences
+         */
+        inline pos_t num_occ() const
+        {
+            return s_fwd.e >= s_fwd.b ? s_fwd.e - s_fwd.b + 1 : 0;
+        }
+
+        /**
+         * @brief returns the suffix array interval of the currently matched pattern P in the index of T
+         * @return suffix array interval of P
+         */
+        inline std::pair<pos_t, pos_t> sa_interval() const
+        {
+            return std::make_pair(s_fwd.b, s_fwd.e);
+        }
+
+        /**
+         * @brief returns the suffix array interval of rev(P) in the index of rev(T), where P is the currently matched pattern
+         * @return suffix array interval of rev(P)
+         */
+        inline std::pair<pos_t, pos_t> sa_interval_rev() const
+        {
+            return std::make_pair(s_rev.b, s_rev.e);
+        }
+
+        /**
+         * @brief prepends sym to the currently matched pattern P; if symP occurs in the input, true is
+         * returned and the query context is adjusted to store the information for the pattern symP; else,
+         * false is returned and the query context is not modified
+         * @param sym
+         * @return whether symP occurs in the input
+         */
+        bool prepend(sym_t sym)
+        {
+            if (extend(idx->idx_fwd, idx->rmq_fwd, s_fwd, idx->idx_rev, s_rev, sym)) {
+                l++;
+                return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief appends sym to the currently matched pattern P; if Psym occurs in the input, true is
+         * returned and the query context is adjusted to store the information for the pattern Psym; else,
+         * false is returned and the query context is not modified
+         * @param sym
+         * @return whether Psym occurs in the input
+         */
+        bool append(sym_t sym)
+        {
+            if (extend(idx->idx_rev, idx->rmq_rev, s_rev, idx->idx_fwd, s_fwd, sym)) {
+                l++;
+                return true;
+            }
+
+            return false;
+        }
+    };
+
+    /**
+     * @brief returns a bidirectional query context for the index
+     * @return bidirectional_query_context
+     */
+    inline bidirectional_query_context query() const
+    {
+        return bidirectional_query_context(*this);
+    }
+};
\ No newline at end of file
@@ -62,7 +62,11 @@ TEST(test_move_data_structure, fuzzy_test)
         uint16_t a = std::min<uint16_t>(2 + a_distrib(gen), 32767);
 
         // build a move data structure from the disjoint interval sequence
-        move_data_structure<uint32_t> mds(interval_sequence, input_size, { .num_threads = num_threads_distrib(gen), .a = a });
+        move_data_structure<uint32_t> mds(interval_sequence, input_size,
+            { .num_threads = num_threads_distrib(gen), .a = a, .huge_pages = gen() % 2 == 0 });
+
+        // check if the construction has left the global number of OpenMP threads unchanged
+        EXPECT_EQ(omp_get_max_threads(), max_num_threads);
 
         // check if the number of input/output intervals has increased too much
         EXPECT_TRUE(mds.num_intervals() / (double)num_intervals <= (a / (double)(a - 1)) * 1.125);
@@ -104,4 +108,178 @@ TEST(test_move_data_structure, fuzzy_test)
 
         interval_sequence.clear();
     }
+}
+
+TEST(test_move_data_structure, packed_input)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    uint16_t max_num_threads = omp_get_max_threads();
+
+    std::uniform_int_distribution<uint64_t> input_size_distrib(1, 100000);
+    std::uniform_int_distribution<uint64_t> interval_length_distrib(1, 64);
+    std::uniform_int_distribution<uint16_t> num_threads_distrib(1, max_num_threads);
+    std::uniform_int_distribution<uint16_t> version_distrib(1, 6);
+
+    for (uint16_t t = 0; t < 20; t++) {
+        // generate a random disjoint interval sequence
+        uint64_t input_size = input_size_distrib(gen);
+        std::vector<std::pair<uint64_t, uint64_t>> interval_sequence;
+        std::vector<uint64_t> interval_lengths;
+
+        for (uint64_t p = 0; p < input_size;) {
+            uint64_t d = std::min<uint64_t>(interval_length_distrib(gen), input_size - p);
+            interval_sequence.emplace_back(p, 0);
+            interval_lengths.emplace_back(d);
+            p += d;
+        }
+
+        std::vector<uint64_t> interval_permutation(interval_sequence.size());
+        std::iota(interval_permutation.begin(), interval_permutation.end(), 0);
+        std::shuffle(interval_permutation.begin(), interval_permutation.end(), gen);
+
+        for (uint64_t i = 0, q = 0; i < interval_permutation.size(); i++) {
+            interval_sequence[interval_permutation[i]].second = q;
+            q += interval_lengths[interval_permutation[i]];
+        }
+
+        // build move data structures from the unpacked and the 40-bit packed interval sequence and compare them
+        std::vector<std::pair<uint40_t, uint40_t>> interval_sequence_packed;
+
+        for (auto [p, q] : interval_sequence) {
+            interval_sequence_packed.emplace_back(uint40_t(p), uint40_t(q));
+        }
+
+        mds_params params { .num_threads = num_threads_distrib(gen), .a = 4, .version = (uint8_t)version_distrib(gen) };
+        move_data_structure<uint64_t> mds(interval_sequence, input_size, params);
+        move_data_structure<uint64_t> mds_packed(std::move(interval_sequence_packed), input_size, params);
+
+        EXPECT_EQ(mds.num_intervals(), mds_packed.num_intervals());
+
+        for (uint64_t i = 0; i < mds.num_intervals(); i++) {
+            EXPECT_EQ(mds.p(i), mds_packed.p(i));
+            EXPECT_EQ(mds.q(i), mds_packed.q(i));
+        }
+    }
+}
+
+TEST(test_move_data_structure, v6)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    uint16_t max_num_threads = omp_get_max_threads();
+
+    std::uniform_int_distribution<uint32_t> input_size_distrib(1, 200000);
+    std::uniform_int_distribution<uint32_t> interval_length_distrib(1, 64);
+    std::uniform_int_distribution<uint16_t> num_threads_distrib(1, max_num_threads);
+    std::uniform_int_distribution<uint16_t> a_distrib(2, 16);
+
+    for (uint16_t t = 0; t < 100; t++) {
+        // generate a random disjoint interval sequence
+        uint32_t input_size = input_size_distrib(gen);
+        std::vector<std::pair<uint32_t, uint32_t>> interval_sequence;
+        std::vector<uint32_t> interval_lengths;
+
+        for (uint32_t p = 0; p < input_size;) {
+            uint32_t d = std::min<uint32_t>(interval_length_distrib(gen), input_size - p);
+            interval_sequence.emplace_back(p, 0);
+            interval_lengths.emplace_back(d);
+            p += d;
+        }
+
+        uint32_t num_intervals = interval_sequence.size();
+        std::vector<uint32_t> interval_permutation(num_intervals);
+        std::iota(interval_permutation.begin(), interval_permutation.end(), 0);
+        std::shuffle(interval_permutation.begin(), interval_permutation.end(), gen);
+
+        for (uint32_t i = 0, q = 0; i < num_intervals; i++) {
+            interval_sequence[interval_permutation[i]].second = q;
+            q += interval_lengths[interval_permutation[i]];
+        }
+
+        // build a move data structure from the disjoint interval sequence with the array-based balancing method
+        uint16_t a = a_distrib(gen);
+        move_data_structure<uint32_t> mds(interval_sequence, input_size,
+            { .num_threads = num_threads_distrib(gen), .a = a, .version = 6 });
+
+        // check if the number of input/output intervals has increased too much
+        EXPECT_TRUE(mds.num_intervals() / (double)num_intervals <= (a / (double)(a - 1)) * 1.125);
+
+        // check if there is an a-heavy output interval
+        for (uint32_t i = 0; i < mds.num_intervals(); i++) {
+            uint32_t j = bin_search_min_geq<uint32_t>(mds.q(i), 0, mds.num_intervals() - 1, [&mds](auto x) { return mds.p(x); });
+            uint16_t num_intervals_in_output_interval = 0;
+
+            while (mds.p(j) < mds.q(i) + (mds.p(i + 1) - mds.p(i))) {
+                num_intervals_in_output_interval++;
+                j++;
+            }
+
+            EXPECT_LE(num_intervals_in_output_interval, 2 * a);
+        }
+
+        // compare the results of move queries on every position with the original interval sequence
+        for (uint32_t i = 0; i < input_size; i++) {
+            std::pair<uint32_t, uint32_t> ix_mds { i,
+                bin_search_max_leq<uint32_t>(i, 0, mds.num_intervals() - 1, [&mds](uint32_t x) { return mds.p(x); }) };
+
+            uint32_t x = bin_search_max_leq<uint32_t>(i, 0, num_intervals - 1, [&interval_sequence](uint32_t x) { return interval_sequence[x].first; });
+
+            ix_mds = mds.move(ix_mds);
+            EXPECT_EQ(ix_mds.first, interval_sequence[x].second + (i - interval_sequence[x].first));
+            EXPECT_TRUE(mds.p(ix_mds.second) <= ix_mds.first && ix_mds.first < mds.p(ix_mds.second + 1));
+        }
+    }
+}
+
+TEST(test_move_data_structure, v5_multi_threaded)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    uint16_t max_num_threads = std::max<uint16_t>(2, omp_get_max_threads());
+
+    std::uniform_int_distribution<uint32_t> input_size_distrib(100000, 400000);
+    std::uniform_int_distribution<uint32_t> interval_length_distrib(1, 16);
+    std::uniform_int_distribution<uint32_t> long_interval_length_distrib(1, 10000);
+    std::uniform_int_distribution<uint16_t> num_threads_distrib(2, std::min<uint16_t>(max_num_threads, 8));
+
+    for (uint16_t t = 0; t < 20; t++) {
+        // generate a random disjoint interval sequence with enough intervals for version 5 and some very long
+        // intervals, s.t. the parallel splitting of the input intervals (and the subsequent merging) is exercised
+        uint32_t input_size = input_size_distrib(gen);
+        std::vector<std::pair<uint32_t, uint32_t>> interval_sequence;
+        std::vector<uint32_t> interval_lengths;
+
+        for (uint32_t p = 0; p < input_size;) {
+            uint32_t d = std::min<uint32_t>(gen() % 64 == 0 ? long_interval_length_distrib(gen) : interval_length_distrib(gen), input_size - p);
+            interval_sequence.emplace_back(p, 0);
+            interval_lengths.emplace_back(d);
+            p += d;
+        }
+
+        uint32_t num_intervals = interval_sequence.size();
+        std::vector<uint32_t> interval_permutation(num_intervals);
+        std::iota(interval_permutation.begin(), interval_permutation.end(), 0);
+        std::shuffle(interval_permutation.begin(), interval_permutation.end(), gen);
+
+        for (uint32_t i = 0, q = 0; i < num_intervals; i++) {
+            interval_sequence[interval_permutation[i]].second = q;
+            q += interval_lengths[interval_permutation[i]];
+        }
+
+        move_data_structure<uint32_t> mds(interval_sequence, input_size,
+            { .num_threads = num_threads_distrib(gen), .a = 8, .version = 5 });
+
+        // compare the results of move queries on every position with the original interval sequence
+        for (uint32_t i = 0; i < input_size; i++) {
+            std::pair<uint32_t, uint32_t> ix_mds { i,
+                bin_search_max_leq<uint32_t>(i, 0, mds.num_intervals() - 1, [&mds](uint32_t x) { return mds.p(x); }) };
+
+            uint32_t x = bin_search_max_leq<uint32_t>(i, 0, num_intervals - 1, [&interval_sequence](uint32_t x) { return interval_sequence[x].first; });
+
+            ix_mds = mds.move(ix_mds);
+            EXPECT_EQ(ix_mds.first, interval_sequence[x].second + (i - interval_sequence[x].first));
+            EXPECT_TRUE(mds.p(ix_mds.second) <= ix_mds.first && ix_mds.first < mds.p(ix_mds.second + 1));
+        }
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <move_r/move_r.hpp>
+#include <move_r/move_r_bidirectional.hpp>
 
 std::random_device rd;
 std::mt19937 gen(rd());
@@ -15,6 +16,7 @@ std::lognormal_distribution<double> a_distrib(2.0, 3.0);
 
 uint32_t input_size;
 uint8_t alphabet_size;
+std::vector<uint8_t> alphabet;
 std::string input;
 std::string input_reverted;
 std::string bwt;
@@ -26,8 +28,12 @@ std::vector<uint32_t> suffix_array_retrieved;
 uint32_t max_pattern_length;
 uint32_t num_queries;
 
-template <move_r_support support>
-void test_move_r()
+/**
+ * @brief chooses a random alphabet of alphabet_size symbols in [min_uchar..255] and stores it in alphabet, then
+ * chooses a random repetitive input over this alphabet and stores it in input
+ * @param min_uchar smallest symbol that may occur in the input (0 or 1)
+ */
+void generate_input(uint8_t min_uchar = 1)
 {
     // choose a random input length
     input_size = input_size_distrib(gen);
@@ -36,14 +42,14 @@ void test_move_r()
     alphabet_size = alphabet_size_distrib(gen);
 
     // choose a random alphabet
-    std::vector<uint8_t> alphabet;
+    alphabet.clear();
     alphabet.reserve(alphabet_size);
     uint8_t uchar;
 
     for (uint32_t i = 0; i < alphabet_size; i++) {
         do {
             uchar = uchar_distrib(gen);
-        } while (contains(alphabet, uchar));
+        } while (uchar < min_uchar || contains(alphabet, uchar));
 
         alphabet.push_back(uchar);
     }
@@ -52,7 +58,8 @@ void test_move_r()
     std::uniform_int_distribution<uint8_t> char_idx_distrib(0, alphabet_size - 1);
     double avg_input_rep_length = 1.0 + avg_input_rep_length_distrib(gen);
     uint8_t cur_uchar = alphabet[char_idx_distrib(gen)];
-    input.reserve(input_size);
+    input.clear();
+    input.reserve(input_size + 1);
 
     for (uint32_t i = 0; i < input_size; i++) {
         if (prob_distrib(gen) < 1 / avg_input_rep_length)
@@ -60,15 +67,64 @@ void test_move_r()
 
         input.push_back(uchar_to_char(cur_uchar));
     }
+}
+
+/**
+ * @brief computes the suffix array of input (which must not contain 0) terminated by 0 and stores it in suffix_array
+ */
+void compute_suffix_array()
+{
+    input.push_back(uchar_to_char((uint8_t)0));
+    no_init_resize(suffix_array, input_size + 1);
+    libsais_omp((uint8_t*)&input[0], &suffix_array[0], input_size + 1, 0, NULL, max_num_threads);
+    input.pop_back();
+}
 
-    // build move-r and choose a random number of threads and balancing parameter, but always use libsais,
-    // because there are bugs in Big-BWT that come through during fuzzing but not really in practice
+/**
+ * @brief reverts the index and compares the output with input; if the index supports locate, it also checks if
+ * the index stores the correct suffix array
+ * @param index an index of input
+ * @param check_sa controls whether to check the suffix array (input must not contain 0 then)
+ */
+template <move_r_support support>
+void check_index(move_r<support, char, uint32_t>& index, bool check_sa = true)
+{
+    // revert the index and compare the output with the input string
+    input_reverted = index.revert({ .num_threads = num_threads_distrib(gen) });
+
+    for (uint32_t i = 0; i < input_size; i++)
+        EXPECT_EQ(input[i], input_reverted[i]);
+
+    // check if the index stores the correct suffix array
+    if constexpr (support != _count) {
+        if (check_sa) {
+            compute_suffix_array();
+            suffix_array_retrieved = index.SA({ .num_threads = num_threads_distrib(gen) });
+
+            for (uint32_t i = 0; i <= input_size; i++)
+                EXPECT_EQ(suffix_array[i], suffix_array_retrieved[i]);
+        }
+    }
+}
+
+template <move_r_support support, move_r_construction_mode mode = _suffix_array>
+void test_move_r()
+{
+    // choose a random input over a random alphabet, which may contain 0
+    generate_input(0);
+
+    // build move-r and choose a random number of threads and balancing parameter
     move_r<support, char, uint32_t> index(input, {
-        .mode = _suffix_array,
+        .mode = mode,
         .num_threads = num_threads_distrib(gen),
         .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
     });
 
+    // choose a random threshold, s.t. both M_Phi^{-1} and the rlzdsa are used to answer locate queries
+    if constexpr (support == _locate_hybrid) {
+        index.set_min_occ_threshold(std::uniform_int_distribution<uint32_t>(1, 64)(gen));
+    }
+
     // revert the index and compare the output with the input string
     input_reverted = index.revert({ .num_threads = num_threads_distrib(gen) });
 
@@ -202,10 +258,696 @@ TEST(test_move_r, fuzzy_test)
     auto start_time = now();
 
     while (time_diff_min(start_time, now()) < 60) {
-        if (prob_distrib(gen) < 0.5) {
+        double prob = prob_distrib(gen);
+
+        if (prob < 1.0 / 3.0) {
             test_move_r<_locate_move>();
-        } else {
+        } else if (prob < 2.0 / 3.0) {
             test_move_r<_locate_rlzdsa>();
+        } else {
+            test_move_r<_locate_hybrid>();
+        }
+    }
+}
+
+TEST(test_move_r, pfp)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        test_move_r<_locate_move, _pfp>();
+        test_move_r<_locate_rlzdsa, _pfp>();
+        test_move_r<_locate_hybrid, _pfp>();
+    }
+}
+
+TEST(test_move_r, rlzdsa_reproducible)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build the index twice with the same seed and number of threads; the reference must be the same
+        move_r_params params = {
+            .mode = _suffix_array,
+            .num_threads = num_threads_distrib(gen),
+            .seed = gen()
+        };
+
+        move_r<_locate_rlzdsa, char, uint32_t> index_1(input, params);
+        move_r<_locate_rlzdsa, char, uint32_t> index_2(input, params);
+
+        EXPECT_EQ(index_1.num_phrases_rlzdsa(), index_2.num_phrases_rlzdsa());
+        EXPECT_EQ(index_1.R().size(), index_2.R().size());
+
+        if (index_1.R().size() == index_2.R().size()) {
+            for (uint64_t i = 0; i < index_1.R().size(); i++)
+                EXPECT_EQ(index_1.R()[i], index_2.R()[i]);
+        }
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, rlzdsa_shared_reference)
+{
+    std::string path_reference = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // export the reference of an index of the input
+        move_r<_locate_rlzdsa, char, uint32_t> index_ref(input, { .num_threads = num_threads_distrib(gen) });
+        std::ofstream reference_file_out(path_reference);
+        index_ref.export_reference(reference_file_out, num_threads_distrib(gen));
+        reference_file_out.close();
+
+        // build an index of a modified version of the input relative to this reference
+        std::uniform_int_distribution<uint8_t> char_idx_distrib(0, alphabet_size - 1);
+        std::uniform_int_distribution<uint32_t> pos_distrib(0, input_size - 1);
+
+        for (uint32_t i = 0; i < 1 + input_size / 1000; i++)
+            input[pos_distrib(gen)] = uchar_to_char(alphabet[char_idx_distrib(gen)]);
+
+        bool embed_reference = prob_distrib(gen) < 0.5;
+        move_r<_locate_rlzdsa, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .path_reference = path_reference,
+            .embed_reference = embed_reference
+        });
+
+        // serialize and load the index and check it
+        std::stringstream index_stream;
+        index.serialize(index_stream);
+        index = move_r<_locate_rlzdsa, char, uint32_t>();
+        index.load(index_stream);
+        check_index(index);
+
+        input.clear();
+    }
+
+    std::filesystem::remove(path_reference);
+}
+
+TEST(test_move_r, tuning)
+{
+    for (uint32_t iter = 0; iter < 5; iter++) {
+        generate_input();
+
+        // sample patterns from the input
+        std::uniform_int_distribution<uint32_t> pattern_pos_distrib(0, input_size - 1);
+        std::uniform_int_distribution<uint32_t> pattern_length_distrib(1, 20);
+        std::vector<std::string> patterns;
+
+        for (uint32_t i = 0; i < 100; i++) {
+            uint32_t pattern_pos = pattern_pos_distrib(gen);
+            patterns.emplace_back(input.substr(pattern_pos, pattern_length_distrib(gen)));
+        }
+
+        // build a tuned index and check if the chosen parameters are stored in the index
+        move_r<_locate_rlzdsa, char, uint32_t> index(input, patterns, {
+            .a = { 2, 8 },
+            .sr_scp = { 1, 4 },
+            .max_scan_l_ = { 16, 128 },
+            .num_repetitions = 1
+        }, { .num_threads = num_threads_distrib(gen) });
+
+        uint16_t a = index.balancing_parameter();
+        uint32_t sr_scp = index.sample_rate_rlzdsa();
+        uint32_t max_scan_l_ = index.max_scan_length();
+        EXPECT_TRUE(a == 2 || a == 8);
+        EXPECT_TRUE(sr_scp == 1 || sr_scp == 4);
+        EXPECT_TRUE(max_scan_l_ == 16 || max_scan_l_ == 128);
+
+        std::stringstream index_stream;
+        index.serialize(index_stream);
+        index = move_r<_locate_rlzdsa, char, uint32_t>();
+        index.load(index_stream);
+
+        EXPECT_EQ(index.balancing_parameter(), a);
+        EXPECT_EQ(index.sample_rate_rlzdsa(), sr_scp);
+        EXPECT_EQ(index.max_scan_length(), max_scan_l_);
+        check_index(index);
+
+        input.clear();
+    }
+}
+
+template <move_r_support support>
+void test_rebalance()
+{
+    generate_input();
+
+    // build the index with a random balancing parameter and rebalance it to another random balancing parameter
+    move_r<support, char, uint32_t> index(input, {
+        .num_threads = num_threads_distrib(gen),
+        .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+    });
+
+    uint16_t a = std::min<uint16_t>(2 + a_distrib(gen), 32767);
+    index.rebalance(a, num_threads_distrib(gen));
+    EXPECT_EQ(index.balancing_parameter(), a);
+    check_index(index);
+
+    input.clear();
+}
+
+TEST(test_move_r, rebalance)
+{
+    for (uint32_t iter = 0; iter < 5; iter++) {
+        test_rebalance<_locate_move>();
+        test_rebalance<_locate_rlzdsa>();
+        test_rebalance<_locate_hybrid>();
+    }
+}
+
+template <move_r_support support>
+void test_rlbwt()
+{
+    generate_input();
+    compute_suffix_array();
+
+    // compute the runs of the bwt, where some runs are split randomly (they have to be merged again)
+    std::string run_heads;
+    std::vector<uint32_t> run_lengths;
+
+    for (uint32_t i = 0; i <= input_size; i++) {
+        char c = suffix_array[i] == 0 ? 0 : input[suffix_array[i] - 1];
+
+        if (run_heads.empty() || run_heads.back() != c || prob_distrib(gen) < 0.01) {
+            run_heads.push_back(c);
+            run_lengths.push_back(1);
+        } else {
+            run_lengths.back()++;
+        }
+    }
+
+    move_r<support, char, uint32_t> index(run_heads, run_lengths, {
+        .num_threads = num_threads_distrib(gen),
+        .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+    });
+
+    check_index(index);
+
+    input.clear();
+}
+
+TEST(test_move_r, rlbwt)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        test_rlbwt<_count>();
+        test_rlbwt<_locate_move>();
+    }
+}
+
+TEST(test_move_r, upgrade)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build a count-only index and add locate support to it
+        move_r<_count, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        move_r<_locate_move, char, uint32_t> index_upgraded = index.upgrade_to<_locate_move>(num_threads_distrib(gen));
+        EXPECT_EQ(index_upgraded.num_bwt_runs(), index.num_bwt_runs());
+        check_index(index_upgraded);
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, downgrade)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build one index and derive the indexes with the other supports from it
+        move_r<_locate_hybrid, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        auto index_count = index.downgrade_to<_count>(num_threads_distrib(gen));
+        auto index_move = index.downgrade_to<_locate_move>(num_threads_distrib(gen));
+        auto index_rlzdsa = index.downgrade_to<_locate_rlzdsa>(num_threads_distrib(gen));
+
+        check_index(index_count);
+        check_index(index_move);
+        check_index(index_rlzdsa);
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, memory_budget)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build the index with a random memory budget between n and 20n bytes, s.t. all construction modes can be chosen
+        std::uniform_int_distribution<uint64_t> max_memory_distrib(input_size + 1, 20 * (input_size + 1));
+
+        move_r<_locate_move, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767),
+            .max_memory = max_memory_distrib(gen)
+        });
+
+        check_index(index);
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, checkpoint)
+{
+    std::string checkpoint_dir = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // write a checkpoint of another input, which must not be resumed
+        std::filesystem::create_directories(checkpoint_dir);
+        std::ofstream manifest(checkpoint_dir + "/manifest");
+        manifest << "move-r-checkpoint" << std::endl << "support " << (uint64_t)_locate_rlzdsa << std::endl
+                 << "pos_t_size 4" << std::endl << "sym_t_size 1" << std::endl << "n " << input_size + 1 << std::endl
+                 << "fingerprint 0" << std::endl << "phase sa sa 0" << std::endl;
+        manifest.close();
+        std::ofstream(checkpoint_dir + "/sa").close();
+
+        move_r<_locate_rlzdsa, char, uint32_t> index(input, {
+            .mode = prob_distrib(gen) < 0.5 ? _suffix_array : _pfp,
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767),
+            .checkpoint_dir = checkpoint_dir,
+            .resume = true
+        });
+
+        // the checkpoint is removed once the construction has finished
+        EXPECT_FALSE(std::filesystem::exists(checkpoint_dir + "/manifest"));
+        check_index(index);
+
+        input.clear();
+    }
+
+    std::filesystem::remove_all(checkpoint_dir);
+}
+
+TEST(test_move_r, resume_checkpoint)
+{
+    std::string checkpoint_dir = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        move_r_params params {
+            .mode = prob_distrib(gen) < 0.5 ? _suffix_array : _pfp,
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767),
+            .checkpoint_dir = checkpoint_dir,
+            .keep_checkpoint = true
+        };
+
+        // write a complete checkpoint by building the index once
+        move_r<_locate_rlzdsa, char, uint32_t> index_checkpoint(input, params);
+
+        // the checkpoint contains the suffix array (or the BWT) and the reference of the rlzdsa
+        std::ifstream manifest(checkpoint_dir + "/manifest");
+        std::stringstream manifest_stream;
+        manifest_stream << manifest.rdbuf();
+        manifest.close();
+        EXPECT_NE(manifest_stream.str().find(params.mode == _pfp ? "phase bwt" : "phase sa"), std::string::npos);
+        EXPECT_NE(manifest_stream.str().find("phase reference"), std::string::npos);
+
+        // resume a construction with another number of threads from the checkpoint
+        params.num_threads = num_threads_distrib(gen);
+        params.resume = true;
+        params.keep_checkpoint = false;
+        move_r<_locate_rlzdsa, char, uint32_t> index(input, params);
+
+        EXPECT_FALSE(std::filesystem::exists(checkpoint_dir + "/manifest"));
+        check_index(index);
+
+        input.clear();
+    }
+
+    std::filesystem::remove_all(checkpoint_dir);
+}
+
+TEST(test_move_r, build_concurrently)
+{
+    std::string tmp_dir = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+    std::filesystem::create_directories(tmp_dir);
+    std::uniform_int_distribution<uint16_t> num_inputs_distrib(1, 8);
+
+    for (uint32_t iter = 0; iter < 10; iter++) {
+        // choose several random repetitive inputs over random alphabets
+        std::vector<std::string> inputs(num_inputs_distrib(gen));
+
+        for (std::string& inp : inputs) {
+            generate_input();
+            inp = std::move(input);
+            input.clear();
+        }
+
+        std::vector<move_r<_locate_move, char, uint32_t>> indexes = move_r<_locate_move, char, uint32_t>::build_concurrently(inputs, {
+            .mode = prob_distrib(gen) < 0.5 ? _suffix_array : _pfp,
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767),
+            .tmp_dir = tmp_dir
+        });
+
+        // the temporary files of all constructions have been removed
+        EXPECT_TRUE(std::filesystem::is_empty(tmp_dir));
+        EXPECT_EQ(omp_get_max_threads(), max_num_threads);
+        ASSERT_EQ(indexes.size(), inputs.size());
+
+        // check each index against its input
+        for (uint16_t j = 0; j < inputs.size(); j++) {
+            input = inputs[j];
+            input_size = input.size();
+            check_index(indexes[j]);
+            input.clear();
+        }
+    }
+
+    std::filesystem::remove_all(tmp_dir);
+}
+
+TEST(test_move_r, parallel_rank_select_support)
+{
+    for (uint32_t iter = 0; iter < 100; iter++) {
+        generate_input(0);
+        std::vector<uint32_t> input_int;
+        input_int.reserve(input_size);
+
+        for (uint32_t i = 0; i < input_size; i++)
+            input_int.push_back(char_to_uchar(input[i]));
+
+        uint16_t p = num_threads_distrib(gen);
+        rank_select_support<char, uint32_t> rs([&](uint32_t i) { return input[i]; }, 0, input_size - 1, p);
+        rank_select_support<uint32_t, uint32_t> rs_int([&](uint32_t i) { return input_int[i]; }, 256, 0, input_size - 1, p);
+
+        // check rank and select against the occurrences in the input
+        std::vector<uint32_t> occ(256, 0);
+
+        for (uint32_t i = 0; i < input_size; i++) {
+            uint8_t uchar = char_to_uchar(input[i]);
+            EXPECT_EQ(rs.rank(input[i], i), occ[uchar]);
+            EXPECT_EQ(rs_int.rank(uchar, i), occ[uchar]);
+            occ[uchar]++;
+            EXPECT_EQ(rs.select(input[i], occ[uchar]), i);
+            EXPECT_EQ(rs_int.select(uchar, occ[uchar]), i);
+        }
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, mmap)
+{
+    std::string path_input = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        // the input contains 0 in half of the iterations, s.t. the memory-mapped input has to be remapped
+        bool remap = prob_distrib(gen) < 0.5;
+        generate_input(remap ? 0 : 1);
+
+        std::ofstream input_file(path_input);
+        input_file.write(input.c_str(), input_size);
+        input_file.close();
+
+        move_r<_locate_move, char, uint32_t> index(std::filesystem::path(path_input), {
+            .mode = prob_distrib(gen) < 0.5 ? _suffix_array : _pfp,
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        // the input file must not have been modified
+        std::ifstream input_ifile(path_input);
+        std::string input_read;
+        no_init_resize(input_read, input_size);
+        read_from_file(input_ifile, input_read.c_str(), input_size);
+        input_ifile.close();
+        EXPECT_EQ(input, input_read);
+
+        // the suffix array of an input containing 0 cannot be computed by compute_suffix_array()
+        check_index(index, !remap);
+
+        input.clear();
+    }
+
+    std::filesystem::remove(path_input);
+}
+
+TEST(test_move_r, m_lf_k)
+{
+    std::uniform_int_distribution<uint8_t> k_distrib(1, 16);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build an index and add M_LF^k to it for a random k
+        move_r<_count, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        index.build_m_lf_k(k_distrib(gen), num_threads_distrib(gen));
+        check_index(index);
+
+        // revert a random range of the index
+        std::uniform_int_distribution<uint32_t> pos_distrib(0, input_size - 1);
+        uint32_t l = pos_distrib(gen);
+        uint32_t r = pos_distrib(gen);
+        if (l > r) std::swap(l, r);
+        input_reverted = index.revert({ .l = l, .r = r, .num_threads = num_threads_distrib(gen) });
+
+        for (uint32_t i = l; i <= r; i++)
+            EXPECT_EQ(input[i], input_reverted[i - l]);
+
+        // serialize and load the index and check it again
+        std::stringstream index_stream;
+        index.serialize(index_stream);
+        index = move_r<_count, char, uint32_t>();
+        index.load(index_stream);
+        check_index(index);
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, m_fl)
+{
+    std::uniform_int_distribution<uint32_t> length_distrib(0, 100);
+
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        // build an index and add M_FL to it
+        move_r<_count, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        index.build_m_fl(num_threads_distrib(gen));
+
+        // serialize and load the index
+        std::stringstream index_stream;
+        index.serialize(index_stream);
+        index = move_r<_count, char, uint32_t>();
+        index.load(index_stream);
+        EXPECT_TRUE(index.has_m_fl());
+
+        // revert the index from left to right and compare the output with the input string
+        input_reverted.clear();
+        index.revert_forward([](uint32_t i, char c) {
+            EXPECT_EQ(i, input_reverted.size());
+            input_reverted.push_back(c);
+        }, { .num_threads = 1 });
+
+        EXPECT_EQ(input, input_reverted);
+        no_init_resize(input_reverted, input_size);
+        index.revert_forward([](uint32_t i, char c) { input_reverted[i] = c; }, { .num_threads = num_threads_distrib(gen) });
+
+        for (uint32_t i = 0; i < input_size; i++)
+            EXPECT_EQ(input[i], input_reverted[i]);
+
+        // extract the input after random suffix array positions and compare it with the input string
+        compute_suffix_array();
+        std::uniform_int_distribution<uint32_t> sa_pos_distrib(0, input_size);
+
+        for (uint32_t q = 0; q < 100; q++) {
+            uint32_t i = sa_pos_distrib(gen);
+            uint32_t m = length_distrib(gen);
+            EXPECT_EQ(index.extract(i, m), input.substr(suffix_array[i], std::min<uint32_t>(m, input_size - suffix_array[i])));
         }
+
+        input.clear();
     }
+}
+
+TEST(test_move_r, bidirectional)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        move_r_bidirectional<_count, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        // returns the suffix array interval of P in an index by backward search
+        auto sa_interval = [](auto& idx, const std::string& P) {
+            auto query = idx.query();
+
+            for (int64_t i = P.size() - 1; i >= 0; i--)
+                query.prepend(P[i]);
+
+            return query.sa_interval();
+        };
+
+        std::uniform_int_distribution<uint8_t> char_idx_distrib(0, alphabet_size - 1);
+        std::uniform_int_distribution<uint32_t> pos_distrib(0, input_size - 1);
+
+        for (uint32_t q = 0; q < 20; q++) {
+            // extend a pattern occurring at a random position in the input randomly to the left and to the right
+            auto query = index.query();
+            uint32_t l = pos_distrib(gen);
+            uint32_t r = l;
+            EXPECT_TRUE(query.append(input[l]));
+
+            for (uint32_t step = 0; step < 32; step++) {
+                if (prob_distrib(gen) < 0.5) {
+                    if (l > 0) {
+                        EXPECT_TRUE(query.prepend(input[l - 1]));
+                        l--;
+                    }
+                } else if (r < input_size - 1) {
+                    EXPECT_TRUE(query.append(input[r + 1]));
+                    r++;
+                }
+
+                // the suffix array intervals of P in T and of rev(P) in rev(T) must be the ones found by backward search
+                std::string P = input.substr(l, r - l + 1);
+                std::string P_rev(P.rbegin(), P.rend());
+                EXPECT_EQ(query.length(), r - l + 1);
+                EXPECT_EQ(query.sa_interval(), sa_interval(index.index_fwd(), P));
+                EXPECT_EQ(query.sa_interval_rev(), sa_interval(index.index_rev(), P_rev));
+                EXPECT_EQ(query.num_occ(), index.index_fwd().count(P));
+
+                // extending the pattern by a random symbol must fail if and only if the extended pattern does not occur
+                char c = uchar_to_char(alphabet[char_idx_distrib(gen)]);
+                auto interval = query.sa_interval();
+                auto interval_rev = query.sa_interval_rev();
+
+                if (!query.append(c)) {
+                    EXPECT_EQ(index.index_fwd().count(P + c), 0);
+                    EXPECT_EQ(query.sa_interval(), interval);
+                    EXPECT_EQ(query.sa_interval_rev(), interval_rev);
+                } else {
+                    EXPECT_EQ(query.sa_interval(), sa_interval(index.index_fwd(), P + c));
+                    query.reset();
+
+                    for (uint32_t i = l; i <= r; i++)
+                        EXPECT_TRUE(query.append(input[i]));
+                }
+            }
+        }
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, children)
+{
+    for (uint32_t iter = 0; iter < 20; iter++) {
+        generate_input();
+
+        move_r<_locate_move, char, uint32_t> index(input, {
+            .num_threads = num_threads_distrib(gen),
+            .a = std::min<uint16_t>(2 + a_distrib(gen), 32767)
+        });
+
+        std::uniform_int_distribution<uint32_t> pos_distrib(0, input_size - 1);
+        std::uniform_int_distribution<uint32_t> length_distrib(0, 4);
+
+        for (uint32_t q = 0; q < 20; q++) {
+            // choose a random pattern that occurs in the input (possibly the empty pattern)
+            uint32_t pos = pos_distrib(gen);
+            std::string P = input.substr(pos, std::min<uint32_t>(length_distrib(gen), input_size - pos));
+            auto query = index.query();
+
+            for (int64_t i = P.size() - 1; i >= 0; i--)
+                query.prepend(P[i]);
+
+            // the children must be the query contexts of exactly the patterns cP that occur in the input
+            auto children = query.children();
+            std::vector<bool> is_child(256, false);
+
+            for (auto& [c, child] : children) {
+                is_child[char_to_uchar(c)] = true;
+                std::string cP = c + P;
+                auto query_cp = index.query();
+
+                for (int64_t i = cP.size() - 1; i >= 0; i--)
+                    query_cp.prepend(cP[i]);
+
+                EXPECT_EQ(child.length(), cP.size());
+                EXPECT_EQ(child.sa_interval(), query_cp.sa_interval());
+
+                // the child must also be able to locate the occurrences of cP
+                std::vector<uint32_t> occurrences = child.locate();
+                std::vector<uint32_t> occurrences_cp = index.locate(cP);
+                ips4o::sort(occurrences.begin(), occurrences.end());
+                ips4o::sort(occurrences_cp.begin(), occurrences_cp.end());
+                EXPECT_EQ(occurrences, occurrences_cp);
+            }
+
+            for (uint8_t uchar : alphabet) {
+                if (!is_child[uchar]) {
+                    EXPECT_EQ(index.count(uchar_to_char(uchar) + P), 0);
+                }
+            }
+        }
+
+        input.clear();
+    }
+}
+
+TEST(test_move_r, invalid_files)
+{
+    std::string path_reference = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+    std::string tmp_dir = std::filesystem::temp_directory_path().string() + "/move-r_test_" + random_alphanumeric_string(10);
+    std::filesystem::create_directories(tmp_dir);
+    generate_input();
+
+    move_r<_locate_rlzdsa, char, uint32_t> index(input, { .num_threads = num_threads_distrib(gen) });
+    std::stringstream index_stream;
+    index.serialize(index_stream);
+
+    // an index must only be loaded into an index object of the same type
+    move_r<_locate_rlzdsa, char, uint64_t> index_64;
+    EXPECT_THROW(index_64.load(index_stream), std::runtime_error);
+    index_stream.seekg(0, std::ios::beg);
+    move_r<_locate_move, char, uint32_t> index_move;
+    EXPECT_THROW(index_move.load(index_stream), std::runtime_error);
+    std::stringstream invalid_stream("no index");
+    EXPECT_THROW(index.load(invalid_stream), std::runtime_error);
+
+    // building relative to a missing or an invalid reference file must fail
+    EXPECT_THROW((move_r<_locate_rlzdsa, char, uint32_t>(input, { .path_reference = path_reference, .tmp_dir = tmp_dir })), std::runtime_error);
+    std::ofstream reference_file_out(path_reference);
+    reference_file_out << "no reference";
+    reference_file_out.close();
+    EXPECT_THROW((move_r<_locate_rlzdsa, char, uint32_t>(input, { .path_reference = path_reference, .tmp_dir = tmp_dir })), std::runtime_error);
+    std::filesystem::remove(path_reference);
+
+    // memory-mapping a missing input file must fail
+    EXPECT_THROW((move_r<_locate_move, char, uint32_t>(std::filesystem::path(path_reference), { .tmp_dir = tmp_dir })), std::runtime_error);
+
+    // the temporary files of the failed constructions have been removed
+    EXPECT_TRUE(std::filesystem::is_empty(tmp_dir));
+    std::filesystem::remove_all(tmp_dir);
+    input.clear();
 }
\ No newline at end of file
@@ -55,8 +55,8 @@ void test_move_r_int()
         input.emplace_back(cur_symbol);
     }
 
-    // build move-r and choose a random number of threads and balancing parameter, but always use libsais,
-    // because there are bugs in Big-BWT that come through during fuzzing but not really in practice
+    // build move-r and choose a random number of threads and balancing parameter (prefix-free parsing is
+    // only supported for byte alphabets, so always use libsais)
     move_r<support, int32_t, uint32_t> index(input, {
         .mode = _suffix_array,
         .num_threads = num_threads_distrib(gen),